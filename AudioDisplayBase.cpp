@@ -1,100 +1,358 @@
-/* Copyright 2020, 2022 Dan Williams. All Rights Reserved.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy of this
- * software and associated documentation files (the "Software"), to deal in the Software
- * without restriction, including without limitation the rights to use, copy, modify, merge,
- * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
- * to whom the Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all copies or
- * substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
- * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
- * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
- * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
- * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-#include <assert.h>
-#include "AudioDisplayBase.h"
-#include "gradientToScale.h"
-
-
-AudioDisplayBase::AudioDisplayBase(size_t frameSize, size_t numDisplayPoints, float firstLedBrightness, bool mirror):
-   m_numForwardPoints(mirror ? (numDisplayPoints+1)/ 2 : numDisplayPoints),
-   m_numReflectionPoints(numDisplayPoints - m_numForwardPoints),
-   m_frameSize(frameSize),
-   m_displayPoints(m_numForwardPoints),
-   m_numDisplayPoints(m_numForwardPoints),
-   m_numNonBlackPoints(m_numForwardPoints),
-   m_firstLedBrightness(m_numForwardPoints),
-   m_pointsBrightness(m_numForwardPoints, 1.0), // Init to no modification of brightness for all Display Points
-   m_mirror(mirror)
-{
-
-}
-
-void AudioDisplayBase::setGradient(ColorGradient::tGradient& gradient, bool reverseGrad)
-{
-   // Convert input gradient and set brightness.
-   std::vector<ColorScale::tColorPoint> colors;
-   if(reverseGrad)
-   {
-      auto revGrad = Convert::reverseGradient(gradient);
-      Convert::convertGradientToScale(revGrad, colors);
-   }
-   else
-   {
-      Convert::convertGradientToScale(gradient, colors);
-   }
-   std::vector<ColorScale::tBrightnessPoint> brightPoints{{m_firstLedBrightness,0},{1,1}}; // Scale brightness.
-
-   // Set the member variable for defining LED colors.
-   std::unique_lock<std::mutex> lock(m_colorScaleMutex);
-   m_colorScale.reset(new ColorScale(colors, brightPoints));
-}
-
-bool AudioDisplayBase::parsePcm(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp)
-{
-   // For now only handling inputs that match the frame size.
-   assert(numSamp == m_frameSize);
-   return processPcm(samples);
-}
-
-void AudioDisplayBase::fillInLeds(SpecAnLedTypes::tRgbVector& ledColors, float brightness, int gain)
-{
-   fillInDisplayPoints(gain); // Fill in m_displayPoints
-   
-   // Convert m_displayPoints to color via colorScale
-   std::unique_lock<std::mutex> lock(m_colorScaleMutex);
-   for(size_t i = 0; i < m_numNonBlackPoints; ++i)
-   {
-      ledColors[m_numReflectionPoints+i] = m_colorScale->getColor(m_displayPoints[i], brightness * m_pointsBrightness[i]);
-   }
-   for(size_t i = m_numNonBlackPoints; i < m_numDisplayPoints; ++i)
-   {
-      ledColors[m_numReflectionPoints+i].u32 = SpecAnLedTypes::COLOR_BLACK;
-   }
-
-   // Check for Override Points
-   int overridePoints_num = m_overridePoints.size();
-   if((m_overrideStart + overridePoints_num) <= int(ledColors.size()) && m_overrideStart >= 0)
-   {
-      for(int i = 0; i < overridePoints_num; ++i)
-      {
-         ledColors[m_numReflectionPoints+i+m_overrideStart] = m_colorScale->getColor(m_overridePoints[i], brightness * m_pointsBrightness[i]);
-      }
-   }
-
-   // Copy over the relection points.
-   if(m_mirror)
-   {
-      size_t convertVal = m_numForwardPoints + m_numReflectionPoints - 1;
-      for(size_t i = 0; i < m_numReflectionPoints; ++i)
-      {
-         ledColors[i] = ledColors[convertVal - i];
-      }
-   }
-}
-
+/* Copyright 2020, 2022 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <assert.h>
+#include <string.h>
+#include <algorithm>
+#include "AudioDisplayBase.h"
+#include "gradientToScale.h"
+
+typedef float v4sf __attribute__((vector_size(16)));
+
+AudioDisplayBase::AudioDisplayBase(size_t frameSize, size_t numDisplayPoints, float firstLedBrightness, bool mirror, bool stereo, size_t numAnalysisPoints, eResample resample):
+   m_framesReadyIndex(1),
+   m_resample(resample),
+   m_numForwardPoints((mirror || stereo) ? (numDisplayPoints+1)/ 2 : numDisplayPoints),
+   m_numReflectionPoints(numDisplayPoints - m_numForwardPoints),
+   m_frameSize(frameSize),
+   m_displayPoints((numAnalysisPoints > 0 && numAnalysisPoints < m_numForwardPoints) ? numAnalysisPoints : m_numForwardPoints),
+   m_numDisplayPoints(m_displayPoints.size()),
+   m_numNonBlackPoints(m_numDisplayPoints),
+   m_firstLedBrightness(m_numForwardPoints),
+   m_colorScale(nullptr),
+   m_renderLedsEpoch(0),
+   m_colorScaleVersion(0),
+   m_pointsBrightness(m_numDisplayPoints, 1.0), // Init to no modification of brightness for all Display Points
+   m_mirror(mirror || stereo),
+   m_stereo(stereo)
+{
+   if(m_stereo)
+   {
+      m_rightDisplayPoints.resize(m_numDisplayPoints);
+      m_rightPointsBrightness.resize(m_numDisplayPoints, 1.0);
+   }
+
+   if(m_numDisplayPoints < m_numForwardPoints)
+      initResample();
+
+   if(m_mirror)
+   {
+      m_mirrorMap.reset(new LedMap(m_numForwardPoints, m_numReflectionPoints, m_stereo));
+      m_compactLeds.resize(m_mirrorMap->getNumInputs());
+   }
+}
+
+AudioDisplayBase::~AudioDisplayBase()
+{
+   delete m_colorScale.load();
+   for(auto& retired : m_retiredColorScales)
+      delete retired.first;
+}
+
+void AudioDisplayBase::setGradient(ColorGradient::tGradient& gradient, bool reverseGrad)
+{
+   // Convert input gradient and set brightness.
+   std::vector<ColorScale::tColorPoint> colors;
+   if(reverseGrad)
+   {
+      auto revGrad = Convert::reverseGradient(gradient);
+      Convert::convertGradientToScale(revGrad, colors);
+   }
+   else
+   {
+      Convert::convertGradientToScale(gradient, colors);
+   }
+   std::vector<ColorScale::tBrightnessPoint> brightPoints{{m_firstLedBrightness,0},{1,1}}; // Scale brightness.
+
+   // Swap in the new color scale (renderLeds will pick it up the next time it runs).
+   std::unique_lock<std::mutex> lock(m_setGradientMutex);
+   auto oldColorScale = m_colorScale.exchange(new ColorScale(colors, brightPoints));
+   ++m_colorScaleVersion;
+   if(oldColorScale != nullptr)
+      m_retiredColorScales.emplace_back(oldColorScale, m_renderLedsEpoch.load());
+   deleteRetiredColorScales();
+}
+
+void AudioDisplayBase::deleteRetiredColorScales()
+{
+   // A retired color scale can be deleted if renderLeds wasn't running when it was retired (even
+   // epoch) or if renderLeds has finished since then (epoch changed). Any renderLeds that started
+   // after the swap uses the new color scale.
+   auto epoch = m_renderLedsEpoch.load();
+   auto retired = m_retiredColorScales.begin();
+   while(retired != m_retiredColorScales.end())
+   {
+      if((retired->second & 1) == 0 || retired->second != epoch)
+      {
+         delete retired->first;
+         retired = m_retiredColorScales.erase(retired);
+      }
+      else
+      {
+         ++retired;
+      }
+   }
+}
+
+bool AudioDisplayBase::parsePcm(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp)
+{
+   // For now only handling inputs that match the frame size.
+   assert(numSamp == m_frameSize);
+   return processPcm(samples);
+}
+
+void AudioDisplayBase::fillInLeds(SpecAnLedTypes::tRgbVector& ledColors, float brightness, int gain)
+{
+   fillInLeds(ledColors.data(), ledColors.size(), brightness, gain);
+}
+
+void AudioDisplayBase::fillInLeds(SpecAnLedTypes::tRgbColor* ledColors, size_t numLeds, float brightness, int gain)
+{
+   // All the updates have the same time, so the latest update is rendered.
+   updateDisplayPoints(gain, 0.0);
+   renderLeds(ledColors, numLeds, brightness, 0.0);
+}
+
+void AudioDisplayBase::updateDisplayPoints(int gain, double time)
+{
+   fillInDisplayPoints(gain); // Fill in m_displayPoints
+
+   // The latest becomes the previous.
+   auto& frames = m_framesBuffers[m_framesWriteIndex];
+   frames.prev = m_latestFrame;
+   savePointsFrame(m_latestFrame, time);
+   frames.latest = m_latestFrame;
+   m_numFrames = std::min(m_numFrames + 1, 2);
+   frames.numFrames = m_numFrames;
+
+   // Hand the frames to renderLeds.
+   m_framesWriteIndex = m_framesReadyIndex.exchange(m_framesWriteIndex | NEW_FRAMES) & ~NEW_FRAMES;
+}
+
+void AudioDisplayBase::savePointsFrame(tPointsFrame& frame, double time)
+{
+   frame.points = m_displayPoints;
+   frame.pointsBrightness = m_pointsBrightness;
+   frame.rightPoints = m_rightDisplayPoints;
+   frame.rightPointsBrightness = m_rightPointsBrightness;
+   frame.numNonBlackPoints = m_numNonBlackPoints;
+   frame.overridePoints = m_overridePoints;
+   frame.overrideStart = m_overrideStart;
+   frame.time = time;
+}
+
+void AudioDisplayBase::interpolateFrames(const tPointsFrames& frames, double time)
+{
+   auto& prev = frames.prev;
+   auto& latest = frames.latest;
+   m_renderFrame = latest;
+
+   // Lag one update behind 'time', i.e. 'alpha' goes from 0 to 1 over the time between the last two updates.
+   float alpha = 1.0f;
+   if(frames.numFrames > 1 && latest.time > prev.time)
+      alpha = std::min(std::max((time - latest.time) / (latest.time - prev.time), 0.0), 1.0);
+   if(alpha < 1.0f)
+   {
+      float prevWeight = 1.0f - alpha;
+      for(size_t i = 0; i < m_numDisplayPoints; ++i)
+      {
+         m_renderFrame.points[i] = prevWeight * prev.points[i] + alpha * latest.points[i] + 0.5f;
+         m_renderFrame.pointsBrightness[i] = prevWeight * prev.pointsBrightness[i] + alpha * latest.pointsBrightness[i];
+      }
+      for(size_t i = 0; i < m_renderFrame.rightPoints.size(); ++i)
+      {
+         m_renderFrame.rightPoints[i] = prevWeight * prev.rightPoints[i] + alpha * latest.rightPoints[i] + 0.5f;
+         m_renderFrame.rightPointsBrightness[i] = prevWeight * prev.rightPointsBrightness[i] + alpha * latest.rightPointsBrightness[i];
+      }
+      m_renderFrame.numNonBlackPoints = prevWeight * prev.numNonBlackPoints + alpha * latest.numNonBlackPoints + 0.5f;
+   }
+}
+
+void AudioDisplayBase::renderLeds(SpecAnLedTypes::tRgbColor* ledColors, size_t numLeds, float brightness, double time)
+{
+   // Pick up the latest frames (if updateDisplayPoints has handed over new ones).
+   if(m_framesReadyIndex.load() & NEW_FRAMES)
+      m_framesReadIndex = m_framesReadyIndex.exchange(m_framesReadIndex) & ~NEW_FRAMES;
+
+   auto& frames = m_framesBuffers[m_framesReadIndex];
+   if(frames.numFrames == 0 || m_colorScale.load() == nullptr)
+   {
+      // Nothing to display yet.
+      for(size_t i = 0; i < numLeds; ++i)
+         ledColors[i].u32 = SpecAnLedTypes::COLOR_BLACK;
+      return;
+   }
+   interpolateFrames(frames, time);
+
+   // Stretch the display points to the LEDs (if needed).
+   const uint16_t* points = m_renderFrame.points.data();
+   const float* pointsBrightness = m_renderFrame.pointsBrightness.data();
+   const uint16_t* rightPoints = m_renderFrame.rightPoints.data();
+   const float* rightPointsBrightness = m_renderFrame.rightPointsBrightness.data();
+   size_t numNonBlackPoints = m_renderFrame.numNonBlackPoints;
+   if(m_numDisplayPoints < m_numForwardPoints)
+   {
+      resample(points, pointsBrightness, m_ledPoints.data(), m_ledBrightness.data());
+      points = m_ledPoints.data();
+      pointsBrightness = m_ledBrightness.data();
+      if(m_stereo)
+      {
+         resample(rightPoints, rightPointsBrightness, m_rightLedPoints.data(), m_rightLedBrightness.data());
+         rightPoints = m_rightLedPoints.data();
+         rightPointsBrightness = m_rightLedBrightness.data();
+      }
+      numNonBlackPoints = (numNonBlackPoints * m_numForwardPoints + m_numDisplayPoints - 1) / m_numDisplayPoints;
+   }
+
+   // Mirrored displays render the compact buffer, then map it to the LEDs.
+   SpecAnLedTypes::tRgbColor* compactLeds = m_mirror ? m_compactLeds.data() : ledColors;
+
+   // Convert the points to color via colorScale
+   ++m_renderLedsEpoch; // Odd, the current color scale can't be deleted.
+   auto colorScale = m_colorScale.load();
+   for(size_t i = 0; i < numNonBlackPoints; ++i)
+   {
+      compactLeds[i] = colorScale->getColor(points[i], brightness * pointsBrightness[i]);
+   }
+   for(size_t i = numNonBlackPoints; i < m_numForwardPoints; ++i)
+   {
+      compactLeds[i].u32 = SpecAnLedTypes::COLOR_BLACK;
+   }
+
+   // Check for Override Points
+   auto& overridePoints = m_renderFrame.overridePoints;
+   int overrideStart = m_renderFrame.overrideStart;
+   int overridePoints_num = overridePoints.size();
+   if((overrideStart + overridePoints_num) <= int(m_numForwardPoints) && overrideStart >= 0)
+   {
+      for(int i = 0; i < overridePoints_num; ++i)
+      {
+         compactLeds[i+overrideStart] = colorScale->getColor(overridePoints[i], brightness * pointsBrightness[i]);
+      }
+   }
+
+   // The right channel goes after the forward points.
+   if(m_stereo)
+   {
+      for(size_t i = 0; i < m_numForwardPoints; ++i)
+      {
+         compactLeds[m_numForwardPoints+i] = colorScale->getColor(rightPoints[i], brightness * rightPointsBrightness[i]);
+      }
+   }
+
+   ++m_renderLedsEpoch; // Even, done with the color scale.
+
+   if(m_mirror)
+      m_mirrorMap->apply(compactLeds, m_compactLeds.size(), ledColors);
+}
+
+void AudioDisplayBase::initResample()
+{
+   size_t numLeds = m_numForwardPoints;
+   m_resampleIndex.resize(numLeds);
+   for(auto& weights : m_resampleWeights)
+      weights.resize(numLeds);
+   m_resampleIn.resize(m_numDisplayPoints + 3);
+   m_resampleOut.resize(numLeds);
+   m_ledPoints.resize(numLeds);
+   m_ledBrightness.resize(numLeds);
+   if(m_stereo)
+   {
+      m_rightLedPoints.resize(numLeds);
+      m_rightLedBrightness.resize(numLeds);
+   }
+
+   // The first / last LEDs line up with the first / last display points.
+   float scale = numLeds > 1 ? float(m_numDisplayPoints - 1) / float(numLeds - 1) : 0.0f;
+   for(size_t i = 0; i < numLeds; ++i)
+   {
+      float position = i * scale;
+      int index = std::min(int(position), int(m_numDisplayPoints) - 1);
+      float t = position - index;
+      m_resampleIndex[i] = index;
+      if(m_resample == E_RESAMPLE_CUBIC)
+      {
+         // Catmull-Rom
+         float t2 = t * t;
+         float t3 = t2 * t;
+         m_resampleWeights[0][i] = 0.5f * (-t3 + 2.0f*t2 - t);
+         m_resampleWeights[1][i] = 0.5f * (3.0f*t3 - 5.0f*t2 + 2.0f);
+         m_resampleWeights[2][i] = 0.5f * (-3.0f*t3 + 4.0f*t2 + t);
+         m_resampleWeights[3][i] = 0.5f * (t3 - t2);
+      }
+      else
+      {
+         m_resampleWeights[0][i] = 0.0f;
+         m_resampleWeights[1][i] = 1.0f - t;
+         m_resampleWeights[2][i] = t;
+         m_resampleWeights[3][i] = 0.0f;
+      }
+   }
+}
+
+void AudioDisplayBase::resample(const uint16_t* points, const float* pointsBrightness, uint16_t* ledPoints, float* ledBrightness)
+{
+   size_t numLeds = m_numForwardPoints;
+   float* out = m_resampleOut.data();
+
+   interpolate(points);
+   for(size_t i = 0; i < numLeds; ++i)
+      ledPoints[i] = std::min(std::max(out[i] + 0.5f, 0.0f), 65535.0f); // Cubic can overshoot.
+
+   interpolate(pointsBrightness);
+   for(size_t i = 0; i < numLeds; ++i)
+      ledBrightness[i] = std::max(out[i], 0.0f);
+}
+
+template<typename tIn>
+void AudioDisplayBase::interpolate(const tIn* points)
+{
+   // Pad the ends (extend the slope at each end) so every LED can use 4 display points.
+   size_t numPoints = m_numDisplayPoints;
+   float* in = m_resampleIn.data();
+   for(size_t i = 0; i < numPoints; ++i)
+      in[i+1] = points[i];
+   float firstSlope = numPoints > 1 ? in[2] - in[1] : 0.0f;
+   float lastSlope = numPoints > 1 ? in[numPoints] - in[numPoints-1] : 0.0f;
+   in[0] = in[1] - firstSlope;
+   in[numPoints+1] = in[numPoints] + lastSlope;
+   in[numPoints+2] = in[numPoints+1];
+
+   // m_resampleOut[i] = sum of the 4 weights * the 4 display points around LED i.
+   size_t numLeds = m_numForwardPoints;
+   const int32_t* index = m_resampleIndex.data();
+   float* out = m_resampleOut.data();
+   size_t i = 0;
+   for(; i + 4 <= numLeds; i += 4)
+   {
+      v4sf acc = {0.0f, 0.0f, 0.0f, 0.0f};
+      for(int tap = 0; tap < 4; ++tap)
+      {
+         v4sf vals = {in[index[i]+tap], in[index[i+1]+tap], in[index[i+2]+tap], in[index[i+3]+tap]};
+         v4sf weights;
+         memcpy(&weights, &m_resampleWeights[tap][i], sizeof(weights));
+         acc += vals * weights;
+      }
+      memcpy(&out[i], &acc, sizeof(acc));
+   }
+   for(; i < numLeds; ++i)
+   {
+      out[i] = m_resampleWeights[0][i] * in[index[i]]   + m_resampleWeights[1][i] * in[index[i]+1] +
+               m_resampleWeights[2][i] * in[index[i]+2] + m_resampleWeights[3][i] * in[index[i]+3];
+   }
+}
@@ -1,74 +1,168 @@
-/* Copyright 2020, 2022 Dan Williams. All Rights Reserved.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy of this
- * software and associated documentation files (the "Software"), to deal in the Software
- * without restriction, including without limitation the rights to use, copy, modify, merge,
- * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
- * to whom the Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all copies or
- * substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
- * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
- * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
- * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
- * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-#pragma once
-
-#include <stdint.h>
-#include <stddef.h>
-#include <vector>
-#include <memory>
-#include <mutex>
-#include "specAnLedPiTypes.h"
-#include "colorGradient.h"
-#include "colorScale.h"
-
-class AudioDisplayBase
-{
-public:
-   AudioDisplayBase(size_t frameSize, size_t numDisplayPoints, float firstLedBrightness = 0.0, bool mirror = false);
-
-   void setGradient(ColorGradient::tGradient& gradient, bool reverseGrad);
-
-   size_t getFrameSize(){return m_frameSize;}
-
-   bool parsePcm(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp);
-
-   void fillInLeds(SpecAnLedTypes::tRgbVector& ledColors, float brightness, int gain);
-
-private:
-   // Make uncopyable
-   AudioDisplayBase();
-   AudioDisplayBase(AudioDisplayBase const&);
-   void operator=(AudioDisplayBase const&);
-
-   virtual bool processPcm(const SpecAnLedTypes::tPcmSample* samples) = 0;
-
-   virtual void fillInDisplayPoints(int gain) = 0;
-
-protected:
-   size_t m_numForwardPoints;
-   size_t m_numReflectionPoints;
-   size_t m_frameSize;
-   std::vector<uint16_t> m_displayPoints;
-   size_t m_numDisplayPoints;
-
-   size_t m_numNonBlackPoints; // All LEDs after this value will be set to Black.
-
-   std::vector<uint16_t> m_overridePoints;
-   int m_overrideStart = -1;
-
-
-   float m_firstLedBrightness;
-   std::unique_ptr<ColorScale> m_colorScale;
-   std::mutex m_colorScaleMutex;
-
-   // Brightness modifier.
-   std::vector<float> m_pointsBrightness;
-
-   bool m_mirror = false;
-};
+/* Copyright 2020, 2022 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include "specAnLedPiTypes.h"
+#include "colorGradient.h"
+#include "colorScale.h"
+#include "spectralAnalysis.h"
+#include "ledMap.h"
+
+class AudioDisplayBase
+{
+public:
+   typedef enum
+   {
+      E_RESAMPLE_LINEAR,
+      E_RESAMPLE_CUBIC
+   }eResample;
+
+   // 'numAnalysisPoints' > 0 makes the display compute that many points (per half when mirrored /
+   // stereo) which are then stretched to the LEDs. 0 means one point per LED.
+   AudioDisplayBase(size_t frameSize, size_t numDisplayPoints, float firstLedBrightness = 0.0, bool mirror = false, bool stereo = false, size_t numAnalysisPoints = 0, eResample resample = E_RESAMPLE_LINEAR);
+   virtual ~AudioDisplayBase();
+
+   virtual void setGradient(ColorGradient::tGradient& gradient, bool reverseGrad);
+
+   size_t getFrameSize(){return m_frameSize;}
+
+   // Add the shared spectra this display uses to 'spectra' (i.e. AudioLeds needs to run them).
+   virtual void getSpectra(SpectralAnalysis::tSpectrumList& spectra){}
+
+   bool parsePcm(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp);
+
+   // Update the display points and fill in the LEDs from them (i.e. updateDisplayPoints + renderLeds).
+   void fillInLeds(SpecAnLedTypes::tRgbVector& ledColors, float brightness, int gain);
+
+   // Same as above, but fills in 'numLeds' LEDs starting at 'ledColors' (e.g. one zone of the strip).
+   void fillInLeds(SpecAnLedTypes::tRgbColor* ledColors, size_t numLeds, float brightness, int gain);
+
+   // Compute the display points for the latest audio (call after parsePcm returns true). 'time'
+   // (seconds) is when the points were computed.
+   virtual void updateDisplayPoints(int gain, double time);
+
+   // Fill in 'numLeds' LEDs starting at 'ledColors'. The display points are interpolated between
+   // the last two updates, lagging one update behind 'time' (so the LEDs can be refreshed faster
+   // than the display points are updated). Never blocks on 'setGradient' or 'updateDisplayPoints'.
+   // Only one thread at a time may render the LEDs.
+   virtual void renderLeds(SpecAnLedTypes::tRgbColor* ledColors, size_t numLeds, float brightness, double time);
+
+private:
+   // Make uncopyable
+   AudioDisplayBase();
+   AudioDisplayBase(AudioDisplayBase const&);
+   void operator=(AudioDisplayBase const&);
+
+   virtual bool processPcm(const SpecAnLedTypes::tPcmSample* samples) = 0;
+
+   virtual void fillInDisplayPoints(int gain) = 0;
+
+   // The display points from one update.
+   typedef struct
+   {
+      std::vector<uint16_t> points;
+      std::vector<float> pointsBrightness;
+      std::vector<uint16_t> rightPoints;
+      std::vector<float> rightPointsBrightness;
+      size_t numNonBlackPoints;
+      std::vector<uint16_t> overridePoints;
+      int overrideStart;
+      double time;
+   }tPointsFrame;
+
+   // The previous and latest updates.
+   typedef struct
+   {
+      tPointsFrame prev;
+      tPointsFrame latest;
+      int numFrames;
+   }tPointsFrames;
+
+   // Triple buffer, so updateDisplayPoints and renderLeds never wait on each other. Each side owns
+   // one buffer and swaps it with the 'ready' buffer (NEW_FRAMES is set when the writer swaps).
+   static constexpr int NEW_FRAMES = 4;
+   tPointsFrames m_framesBuffers[3];
+   int m_framesWriteIndex = 0; // Only used by updateDisplayPoints.
+   std::atomic<int> m_framesReadyIndex;
+   int m_framesReadIndex = 2; // Only used by renderLeds.
+   tPointsFrame m_latestFrame; // Only used by updateDisplayPoints.
+   int m_numFrames = 0; // Only used by updateDisplayPoints.
+   tPointsFrame m_renderFrame; // Interpolated (only used by renderLeds).
+   void interpolateFrames(const tPointsFrames& frames, double time);
+   void savePointsFrame(tPointsFrame& frame, double time);
+
+   // Stretching the display points to the LEDs (only when there are fewer display points than LEDs).
+   eResample m_resample;
+   std::vector<int32_t> m_resampleIndex; // Per LED, the display point at or before the LED.
+   std::vector<float> m_resampleWeights[4]; // Per LED, the weights of the display points 'index'-1 to 'index'+2.
+   std::vector<float> m_resampleIn; // Display points, padded at both ends.
+   std::vector<float> m_resampleOut;
+   std::vector<uint16_t> m_ledPoints;
+   std::vector<float> m_ledBrightness;
+   std::vector<uint16_t> m_rightLedPoints;
+   std::vector<float> m_rightLedBrightness;
+   void initResample();
+
+   // Mirrored / stereo displays render the forward points (then the right channel points) to a
+   // compact buffer, which is then mapped to the LEDs.
+   std::unique_ptr<LedMap> m_mirrorMap;
+   SpecAnLedTypes::tRgbVector m_compactLeds;
+   void resample(const uint16_t* points, const float* pointsBrightness, uint16_t* ledPoints, float* ledBrightness);
+   template<typename tIn> void interpolate(const tIn* in);
+
+protected:
+   size_t m_numForwardPoints;
+   size_t m_numReflectionPoints;
+   size_t m_frameSize;
+   std::vector<uint16_t> m_displayPoints;
+   size_t m_numDisplayPoints;
+
+   size_t m_numNonBlackPoints; // All LEDs after this value will be set to Black.
+
+   std::vector<uint16_t> m_overridePoints;
+   int m_overrideStart = -1;
+
+
+   float m_firstLedBrightness;
+   // The color scale is swapped in by 'setGradient' without locking out 'renderLeds'. The old color
+   // scale is retired and only deleted once 'renderLeds' can't be using it anymore.
+   std::atomic<ColorScale*> m_colorScale;
+   std::atomic<uint32_t> m_renderLedsEpoch; // Odd while 'renderLeds' is running.
+   std::vector<std::pair<ColorScale*, uint32_t>> m_retiredColorScales; // Color Scale and the epoch it was retired at.
+   std::mutex m_setGradientMutex; // Only one 'setGradient' at a time.
+   std::atomic<uint32_t> m_colorScaleVersion; // Incremented every time the color scale changes.
+   void deleteRetiredColorScales();
+
+   // Brightness modifier.
+   std::vector<float> m_pointsBrightness;
+
+   bool m_mirror = false;
+
+   // Stereo (always mirrored). The reflection points are filled in from the right channel
+   // instead of being copies of the forward points.
+   bool m_stereo = false;
+   std::vector<uint16_t> m_rightDisplayPoints;
+   std::vector<float> m_rightPointsBrightness;
+};
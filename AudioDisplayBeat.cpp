@@ -0,0 +1,81 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <algorithm>
+#include "AudioDisplayBeat.h"
+
+#define MIN_BRIGHTNESS (0.15f)  // Brightness between beats.
+#define FLASH_FADE_BEATS (0.3f) // Time constant of the flash fade out (in beats).
+#define COLOR_STEP (0x2000)     // How far along the gradient the colors move on every beat (1/8th).
+#define COLOR_SPAN (0x8000)     // How much of the (folded) gradient is across the LEDs.
+
+AudioDisplayBeat::AudioDisplayBeat(std::shared_ptr<SpectralAnalysis::Spectrum> spectrum, size_t sampleRate, size_t frameSize, size_t numDisplayPoints, bool mirror):
+   AudioDisplayBase(frameSize, numDisplayPoints, 1.0, mirror),
+   m_spectrum(spectrum),
+   m_frameSec(float(frameSize) / float(sampleRate))
+{
+   m_beatTracker.reset(new BeatTracker(spectrum->getBinFreqs(), 1.0f / m_frameSec));
+
+   // Only compute the part of the spectrum that is actually used (if that is cheaper).
+   int firstBin, numBins;
+   m_beatTracker->getUsedBins(firstBin, numBins);
+   m_usedBins.reset(new SpectralAnalysis::Spectrum::UsedBins(spectrum, firstBin, numBins));
+}
+
+void AudioDisplayBeat::getSpectra(SpectralAnalysis::tSpectrumList& spectra)
+{
+   spectra.push_back(m_spectrum.get());
+}
+
+bool AudioDisplayBeat::processPcm(const SpecAnLedTypes::tPcmSample* samples)
+{
+   // The FFT has already been run by the shared analysis stage, track the beats on each new result.
+   auto updateCount = m_spectrum->getUpdateCount();
+   if(updateCount != m_spectrumUpdateCount && m_spectrum->getPower() != nullptr)
+   {
+      m_spectrumUpdateCount = updateCount;
+      if(m_beatTracker->process(m_spectrum->getPower()->data(), m_spectrum->getResultTime()))
+         m_beat = true;
+   }
+   return true; // Update every frame, so the flash fades out smoothly.
+}
+
+void AudioDisplayBeat::fillInDisplayPoints(int gain)
+{
+   if(m_beat)
+   {
+      m_beat = false;
+      m_flash = 1.0f;
+      m_colorOffset += COLOR_STEP;
+   }
+   else
+   {
+      float fadeSec = FLASH_FADE_BEATS * 60.0f / m_beatTracker->getBpm();
+      m_flash *= expf(-m_frameSec / fadeSec);
+   }
+
+   // The gradient is folded (up then back down) so the colors don't jump where the offset wraps.
+   float brightness = std::max(MIN_BRIGHTNESS, m_flash);
+   for(size_t i = 0; i < m_numDisplayPoints; ++i)
+   {
+      uint16_t pos = m_colorOffset + (i * COLOR_SPAN) / m_numDisplayPoints;
+      m_displayPoints[i] = pos < 0x8000 ? (pos << 1) : ((0xFFFF - pos) << 1);
+      m_pointsBrightness[i] = brightness;
+   }
+}
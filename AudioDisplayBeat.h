@@ -0,0 +1,54 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <memory>
+#include "AudioDisplayBase.h"
+#include "spectralAnalysis.h"
+#include "beatTracker.h"
+
+// Flashes on the beats and steps the colors along the gradient on every beat. Between beats the
+// flash fades out over part of the beat period.
+class AudioDisplayBeat : public AudioDisplayBase
+{
+public:
+   // The FFT must run at least once per 'frameSize' samples (the beat tracker expects a new spectrum every frame).
+   AudioDisplayBeat(std::shared_ptr<SpectralAnalysis::Spectrum> spectrum, size_t sampleRate, size_t frameSize, size_t numDisplayPoints, bool mirror = false);
+
+   void getSpectra(SpectralAnalysis::tSpectrumList& spectra) override;
+
+private:
+   // Make uncopyable
+   AudioDisplayBeat();
+   AudioDisplayBeat(AudioDisplayBeat const&);
+   void operator=(AudioDisplayBeat const&);
+
+   bool processPcm(const SpecAnLedTypes::tPcmSample* samples) override;
+
+   void fillInDisplayPoints(int gain) override;
+
+   std::shared_ptr<const SpectralAnalysis::Spectrum> m_spectrum; // Shared with other displays.
+   uint64_t m_spectrumUpdateCount = 0;
+   std::unique_ptr<BeatTracker> m_beatTracker;
+   std::unique_ptr<SpectralAnalysis::Spectrum::UsedBins> m_usedBins;
+   bool m_beat = false; // A beat since the last display update.
+
+   float m_frameSec;
+   float m_flash = 0.0f;
+   uint16_t m_colorOffset = 0; // Moves along the gradient on every beat.
+};
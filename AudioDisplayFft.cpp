@@ -1,84 +1,133 @@
-/* Copyright 2020, 2022 Dan Williams. All Rights Reserved.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy of this
- * software and associated documentation files (the "Software"), to deal in the Software
- * without restriction, including without limitation the rights to use, copy, modify, merge,
- * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
- * to whom the Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all copies or
- * substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
- * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
- * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
- * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
- * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-#include <math.h>
-#include "AudioDisplayFft.h"
-
-
-
-AudioDisplayFft::AudioDisplayFft(size_t sampleRate, size_t frameSize, size_t numDisplayPoints, eFftColorDisplay colorDisplay, bool mirror):
-   AudioDisplayBase(frameSize, numDisplayPoints, colorDisplay == E_BRIGHTNESS_MAG ? 1.0 : 0.0, mirror),
-   m_fftResult(nullptr),
-   m_brightDisplayType(colorDisplay)
-{
-   // FFT Stuff
-   m_fftRun.reset(new FftRunRate(sampleRate, frameSize, 150.0));
-
-   tFftModifiers mod;
-   mod.startFreq = 300;
-   mod.stopFreq = 12000;
-   mod.clipMin = 0;
-   mod.clipMax = 5000;
-   mod.logScale = false;
-   mod.attenLowFreqs = true;
-   mod.attenLowStartLevel = 0.2;
-   mod.attenLowStopFreq = 6000;
-   mod.fadeAwayAmount = (colorDisplay == E_BRIGHTNESS_MAG ? 50 : 30);
-   m_fftModifier.reset(new FftModifier(sampleRate, frameSize, m_numDisplayPoints, mod));
-
-}
-
-bool AudioDisplayFft::processPcm(const SpecAnLedTypes::tPcmSample* samples)
-{
-   m_fftResult = m_fftRun->run(samples, m_frameSize);
-   return m_fftResult != nullptr;
-}
-
-void AudioDisplayFft::fillInDisplayPoints(int gain)
-{
-   if(m_fftResult != nullptr)
-   {
-      gain *= 6;
-      m_fftModifier->modify(m_fftResult->data());
-
-      if(m_brightDisplayType == E_GRADIENT_MAG)
-      {
-         for(size_t i = 0 ; i < m_numDisplayPoints; ++i)
-         {
-            int32_t ledVal = (int32_t)m_fftResult->data()[i]*gain;
-            if(ledVal > 0xFFFF)
-               ledVal = 0xFFFF;
-            m_displayPoints[i] = ledVal;
-         }
-      }
-      else // E_BRIGHTNESS_MAG
-      {
-         for(size_t i = 0 ; i < m_numDisplayPoints; ++i)
-         {
-            int32_t brightVal = (int32_t)m_fftResult->data()[i]*gain;
-            if(brightVal > 0x10000)
-               brightVal = 0x10000;
-            m_pointsBrightness[i] = float(brightVal) / float(0x10000);
-            m_pointsBrightness[i] = pow(m_pointsBrightness[i], 1.8); // reduce smaller brightness values much more the higher brightness value to give a bigger distinction, since brightness is the only indicator.
-
-            m_displayPoints[i] = (0xFFFF * i + ((m_numDisplayPoints-1)>>1)) / (m_numDisplayPoints-1);
-         }
-      }
-   }
-   m_fftResult = nullptr;
-}
\ No newline at end of file
+/* Copyright 2020, 2022 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include "AudioDisplayFft.h"
+#include "fastMath.h"
+
+
+
+AudioDisplayFft::AudioDisplayFft(std::shared_ptr<SpectralAnalysis::Spectrum> spectrum, size_t frameSize, size_t numDisplayPoints, eFftColorDisplay colorDisplay, bool mirror, float startFreq, float stopFreq, eBandSpacing bandSpacing, size_t numAnalysisPoints):
+   AudioDisplayBase(frameSize, numDisplayPoints, colorDisplay == E_BRIGHTNESS_MAG ? 1.0 : 0.0, mirror, false, numAnalysisPoints, E_RESAMPLE_CUBIC),
+   m_spectrum(spectrum),
+   m_fftResult(nullptr),
+   m_brightDisplayType(colorDisplay)
+{
+   initChannel(spectrum, startFreq, stopFreq, bandSpacing, m_fftModifier, m_fftModified, m_usedBins);
+}
+
+AudioDisplayFft::AudioDisplayFft(std::shared_ptr<SpectralAnalysis::Spectrum> leftSpectrum, std::shared_ptr<SpectralAnalysis::Spectrum> rightSpectrum, size_t frameSize, size_t numDisplayPoints, eFftColorDisplay colorDisplay, float startFreq, float stopFreq, eBandSpacing bandSpacing, size_t numAnalysisPoints):
+   AudioDisplayBase(frameSize, numDisplayPoints, colorDisplay == E_BRIGHTNESS_MAG ? 1.0 : 0.0, true, true, numAnalysisPoints, E_RESAMPLE_CUBIC),
+   m_spectrum(leftSpectrum),
+   m_fftResult(nullptr),
+   m_rightSpectrum(rightSpectrum),
+   m_brightDisplayType(colorDisplay)
+{
+   initChannel(leftSpectrum, startFreq, stopFreq, bandSpacing, m_fftModifier, m_fftModified, m_usedBins);
+   initChannel(rightSpectrum, startFreq, stopFreq, bandSpacing, m_rightFftModifier, m_rightFftModified, m_rightUsedBins);
+}
+
+void AudioDisplayFft::initChannel(std::shared_ptr<SpectralAnalysis::Spectrum> spectrum, float startFreq, float stopFreq, eBandSpacing bandSpacing, std::unique_ptr<FftModifier>& fftModifier, std::vector<uint16_t>& fftModified, std::unique_ptr<SpectralAnalysis::Spectrum::UsedBins>& usedBins)
+{
+   // FFT Stuff
+   tFftModifiers mod;
+   mod.startFreq = startFreq;
+   mod.stopFreq = stopFreq;
+   mod.bandSpacing = bandSpacing;
+   mod.clipMin = 0;
+   mod.clipMax = 5000;
+   mod.logScale = false;
+   mod.attenLowStartLevel = 0.2;
+   mod.attenLowStopFreq = 6000;
+   mod.attenLowFreqs = stopFreq > mod.attenLowStopFreq; // Only when the display covers more than just the low frequencies.
+   mod.attackMs = 0; // Rise instantly.
+   mod.releaseMs = (m_brightDisplayType == E_BRIGHTNESS_MAG ? 280 : 170); // About the same as the old 50 / 30 frame linear fade at 60 frames per second.
+   fftModifier.reset(new FftModifier(spectrum->getBinFreqs(), m_numDisplayPoints, mod));
+   fftModified.resize(m_numDisplayPoints);
+
+   // Only compute the part of the spectrum that is actually displayed (if that is cheaper).
+   int firstBin, numBins;
+   fftModifier->getUsedBins(firstBin, numBins);
+   usedBins.reset(new SpectralAnalysis::Spectrum::UsedBins(spectrum, firstBin, numBins));
+}
+
+void AudioDisplayFft::getSpectra(SpectralAnalysis::tSpectrumList& spectra)
+{
+   spectra.push_back(m_spectrum.get());
+   if(m_rightSpectrum)
+      spectra.push_back(m_rightSpectrum.get());
+}
+
+bool AudioDisplayFft::processPcm(const SpecAnLedTypes::tPcmSample* samples)
+{
+   // The FFT has already been run by the shared analysis stage, just check for a new result.
+   checkForNewResult(m_spectrum.get(), m_spectrumUpdateCount, m_fftResult);
+   if(m_rightSpectrum)
+      checkForNewResult(m_rightSpectrum.get(), m_rightSpectrumUpdateCount, m_rightFftResult);
+   return m_fftResult != nullptr || m_rightFftResult != nullptr;
+}
+
+void AudioDisplayFft::checkForNewResult(const SpectralAnalysis::Spectrum* spectrum, uint64_t& lastUpdateCount, const SpecAnLedTypes::tFftPowerVector*& fftResult)
+{
+   auto updateCount = spectrum->getUpdateCount();
+   if(updateCount != lastUpdateCount)
+   {
+      lastUpdateCount = updateCount;
+      fftResult = spectrum->getPower();
+   }
+}
+
+void AudioDisplayFft::fillInDisplayPoints(int gain)
+{
+   gain *= 6;
+   if(m_fftResult != nullptr)
+      fillInChannel(m_fftResult, m_spectrum->getResultTime(), m_fftModifier.get(), m_fftModified, m_displayPoints, m_pointsBrightness, gain);
+   if(m_rightFftResult != nullptr)
+      fillInChannel(m_rightFftResult, m_rightSpectrum->getResultTime(), m_rightFftModifier.get(), m_rightFftModified, m_rightDisplayPoints, m_rightPointsBrightness, gain);
+   m_fftResult = nullptr;
+   m_rightFftResult = nullptr;
+}
+
+void AudioDisplayFft::fillInChannel(const SpecAnLedTypes::tFftPowerVector* fftResult, double resultTime, FftModifier* fftModifier, std::vector<uint16_t>& fftModified, std::vector<uint16_t>& displayPoints, std::vector<float>& pointsBrightness, int gain)
+{
+   fftModifier->modifyPower(fftResult->data(), fftModified.data(), resultTime);
+
+   if(m_brightDisplayType == E_GRADIENT_MAG)
+   {
+      for(size_t i = 0 ; i < m_numDisplayPoints; ++i)
+      {
+         int32_t ledVal = (int32_t)fftModified[i]*gain;
+         if(ledVal > 0xFFFF)
+            ledVal = 0xFFFF;
+         displayPoints[i] = ledVal;
+      }
+   }
+   else // E_BRIGHTNESS_MAG
+   {
+      for(size_t i = 0 ; i < m_numDisplayPoints; ++i)
+      {
+         int32_t brightVal = (int32_t)fftModified[i]*gain;
+         if(brightVal > 0x10000)
+            brightVal = 0x10000;
+         pointsBrightness[i] = float(brightVal) / float(0x10000);
+
+         displayPoints[i] = (0xFFFF * i + ((m_numDisplayPoints-1)>>1)) / (m_numDisplayPoints-1);
+      }
+      FastMath::pow(pointsBrightness.data(), 1.8f, pointsBrightness.data(), m_numDisplayPoints); // reduce smaller brightness values much more the higher brightness value to give a bigger distinction, since brightness is the only indicator.
+   }
+}
@@ -1,53 +1,74 @@
-/* Copyright 2020, 2022 Dan Williams. All Rights Reserved.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy of this
- * software and associated documentation files (the "Software"), to deal in the Software
- * without restriction, including without limitation the rights to use, copy, modify, merge,
- * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
- * to whom the Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all copies or
- * substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
- * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
- * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
- * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
- * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-#pragma once
-#include <memory>
-#include "AudioDisplayBase.h"
-#include "fftRunRate.h"
-#include "fftModifier.h"
-
-class AudioDisplayFft : public AudioDisplayBase
-{
-public:
-   typedef enum
-   {
-      E_GRADIENT_MAG,   // The position on the gradient indications the magnatude.
-      E_BRIGHTNESS_MAG  // The brighness indications the magnatude. The color of each LED is constant.
-   }eFftColorDisplay;
-
-   AudioDisplayFft(size_t sampleRate, size_t fftSize, size_t numDisplayPoints, eFftColorDisplay colorDisplay, bool mirror = false);
-
-private:
-   // Make uncopyable
-   AudioDisplayFft();
-   AudioDisplayFft(AudioDisplayFft const&);
-   void operator=(AudioDisplayFft const&);
-
-   bool processPcm(const SpecAnLedTypes::tPcmSample* samples) override;
-
-   void fillInDisplayPoints(int gain) override;
-
-   // FFT Stuff
-   std::unique_ptr<FftRunRate> m_fftRun;
-   std::unique_ptr<FftModifier> m_fftModifier;
-
-   SpecAnLedTypes::tFftVector* m_fftResult = nullptr;
-
-   eFftColorDisplay m_brightDisplayType;
+/* Copyright 2020, 2022 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <memory>
+#include "AudioDisplayBase.h"
+#include "spectralAnalysis.h"
+#include "fftModifier.h"
+
+class AudioDisplayFft : public AudioDisplayBase
+{
+public:
+   typedef enum
+   {
+      E_GRADIENT_MAG,   // The position on the gradient indications the magnatude.
+      E_BRIGHTNESS_MAG  // The brighness indications the magnatude. The color of each LED is constant.
+   }eFftColorDisplay;
+
+   // 'numAnalysisPoints' > 0 limits the number of bands that are computed, the bands are stretched to the LEDs.
+   AudioDisplayFft(std::shared_ptr<SpectralAnalysis::Spectrum> spectrum, size_t frameSize, size_t numDisplayPoints, eFftColorDisplay colorDisplay, bool mirror = false, float startFreq = 300, float stopFreq = 12000, eBandSpacing bandSpacing = E_BAND_SPACING_LINEAR, size_t numAnalysisPoints = 0);
+
+   // Stereo, the left channel is displayed on one half of the LEDs and the right channel on the other half (mirrored).
+   AudioDisplayFft(std::shared_ptr<SpectralAnalysis::Spectrum> leftSpectrum, std::shared_ptr<SpectralAnalysis::Spectrum> rightSpectrum, size_t frameSize, size_t numDisplayPoints, eFftColorDisplay colorDisplay, float startFreq = 300, float stopFreq = 12000, eBandSpacing bandSpacing = E_BAND_SPACING_LINEAR, size_t numAnalysisPoints = 0);
+
+   void getSpectra(SpectralAnalysis::tSpectrumList& spectra) override;
+
+private:
+   // Make uncopyable
+   AudioDisplayFft();
+   AudioDisplayFft(AudioDisplayFft const&);
+   void operator=(AudioDisplayFft const&);
+
+   bool processPcm(const SpecAnLedTypes::tPcmSample* samples) override;
+
+   void fillInDisplayPoints(int gain) override;
+
+   // FFT Stuff
+   std::shared_ptr<const SpectralAnalysis::Spectrum> m_spectrum; // Shared with other displays.
+   uint64_t m_spectrumUpdateCount = 0;
+   std::unique_ptr<FftModifier> m_fftModifier;
+   std::unique_ptr<SpectralAnalysis::Spectrum::UsedBins> m_usedBins;
+
+   const SpecAnLedTypes::tFftPowerVector* m_fftResult = nullptr;
+   std::vector<uint16_t> m_fftModified; // FFT result after FftModifier
+
+   // Right channel (stereo only).
+   std::shared_ptr<const SpectralAnalysis::Spectrum> m_rightSpectrum;
+   uint64_t m_rightSpectrumUpdateCount = 0;
+   std::unique_ptr<FftModifier> m_rightFftModifier;
+   std::unique_ptr<SpectralAnalysis::Spectrum::UsedBins> m_rightUsedBins;
+   const SpecAnLedTypes::tFftPowerVector* m_rightFftResult = nullptr;
+   std::vector<uint16_t> m_rightFftModified;
+
+   eFftColorDisplay m_brightDisplayType;
+
+   void initChannel(std::shared_ptr<SpectralAnalysis::Spectrum> spectrum, float startFreq, float stopFreq, eBandSpacing bandSpacing, std::unique_ptr<FftModifier>& fftModifier, std::vector<uint16_t>& fftModified, std::unique_ptr<SpectralAnalysis::Spectrum::UsedBins>& usedBins);
+   void checkForNewResult(const SpectralAnalysis::Spectrum* spectrum, uint64_t& lastUpdateCount, const SpecAnLedTypes::tFftPowerVector*& fftResult);
+   void fillInChannel(const SpecAnLedTypes::tFftPowerVector* fftResult, double resultTime, FftModifier* fftModifier, std::vector<uint16_t>& fftModified, std::vector<uint16_t>& displayPoints, std::vector<float>& pointsBrightness, int gain);
 };
\ No newline at end of file
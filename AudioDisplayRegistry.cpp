@@ -0,0 +1,173 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include "AudioDisplayRegistry.h"
+#include "ThreadPriorities.h"
+
+AudioDisplayRegistry::AudioDisplayRegistry(size_t numLeds):
+   m_numLeds(numLeds)
+{
+   m_prewarm_thread = std::thread(&AudioDisplayRegistry::prewarmFunc, this);
+}
+
+AudioDisplayRegistry::~AudioDisplayRegistry()
+{
+   // Kill the pre-warm thread and join.
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_prewarm_active = false;
+      m_prewarm_condVar.notify_all();
+   }
+   m_prewarm_thread.join();
+}
+
+void AudioDisplayRegistry::registerDisplay(const std::string& name, tFactory factory)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   if(m_factories.count(name) == 0)
+      m_registeredNames.push_back(name);
+   m_factories[name] = factory;
+}
+
+AudioDisplayBase* AudioDisplayRegistry::createDisplay(const std::string& name, size_t numLeds, size_t frameSize)
+{
+   tFactory factory;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto found = m_factories.find(name);
+      if(found == m_factories.end())
+         return nullptr;
+      factory = found->second;
+   }
+   return factory(numLeds, frameSize);
+}
+
+void AudioDisplayRegistry::setDisplayList(const std::vector<std::string>& names)
+{
+   std::vector<std::shared_ptr<AudioDisplayBase>> oldDisplays; // Destruct these outside the lock.
+   std::lock_guard<std::mutex> lock(m_mutex);
+
+   m_displayFactories.clear();
+   for(auto& name : names)
+   {
+      auto factory = m_factories.find(name);
+      if(factory != m_factories.end())
+         m_displayFactories.push_back(factory->second);
+   }
+   if(m_displayFactories.size() == 0)
+   {
+      for(auto& name : m_registeredNames)
+         m_displayFactories.push_back(m_factories[name]);
+   }
+
+   oldDisplays.swap(m_displays);
+   m_displays.resize(m_displayFactories.size());
+   m_activeIndex = 0;
+}
+
+int AudioDisplayRegistry::getNumDisplays()
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_displays.size();
+}
+
+int AudioDisplayRegistry::getActiveIndex()
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_activeIndex;
+}
+
+void AudioDisplayRegistry::setActiveDisplay(int index)
+{
+   std::unique_lock<std::mutex> lock(m_mutex);
+   if(index < 0 || index >= int(m_displays.size()))
+      return;
+
+   if(m_displays[index] == nullptr)
+   {
+      // Not pre-warmed, construct it now (without holding the lock).
+      auto factory = m_displayFactories[index];
+      lock.unlock();
+      std::shared_ptr<AudioDisplayBase> display(factory(m_numLeds, 0));
+      lock.lock();
+      if(m_displays[index] == nullptr)
+         m_displays[index] = display;
+   }
+   m_activeIndex = index;
+
+   // Let the pre-warm thread construct the neighbors (and get rid of the displays that aren't needed anymore).
+   m_prewarm_pending = true;
+   m_prewarm_condVar.notify_all();
+}
+
+std::shared_ptr<AudioDisplayBase> AudioDisplayRegistry::getActiveDisplay()
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_displays[m_activeIndex];
+}
+
+bool AudioDisplayRegistry::isNeighbor(int index)
+{
+   int num = m_displays.size();
+   int prev = (m_activeIndex + num - 1) % num;
+   int next = (m_activeIndex + 1) % num;
+   return index == prev || index == next;
+}
+
+void AudioDisplayRegistry::prewarmFunc()
+{
+   ThreadPriorities::setThisThreadName("DisplayPrewarm");
+   std::unique_lock<std::mutex> lock(m_mutex);
+   while(m_prewarm_active)
+   {
+      // Wait for something to do.
+      while(!m_prewarm_pending && m_prewarm_active)
+         m_prewarm_condVar.wait(lock);
+      m_prewarm_pending = false;
+
+      // Get rid of the displays that aren't active or next to the active display.
+      std::vector<std::shared_ptr<AudioDisplayBase>> unused;
+      for(int i = 0; i < int(m_displays.size()); ++i)
+      {
+         if(i != m_activeIndex && !isNeighbor(i) && m_displays[i] != nullptr)
+         {
+            unused.push_back(nullptr);
+            unused.back().swap(m_displays[i]);
+         }
+      }
+
+      // Construct the neighbors (keep the mutex unlocked while constructing / destructing).
+      for(int i = 0; i < int(m_displays.size()) && m_prewarm_active && !m_prewarm_pending; ++i)
+      {
+         if(isNeighbor(i) && m_displays[i] == nullptr)
+         {
+            auto factory = m_displayFactories[i];
+            lock.unlock();
+            unused.clear();
+            std::shared_ptr<AudioDisplayBase> display(factory(m_numLeds, 0));
+            lock.lock();
+            if(i < int(m_displays.size()) && m_displays[i] == nullptr)
+               m_displays[i] = display;
+         }
+      }
+
+      lock.unlock();
+      unused.clear();
+      lock.lock();
+   }
+}
@@ -0,0 +1,87 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "AudioDisplayBase.h"
+
+// Creates the Audio Displays by name. Only the active display (and the ones next to it, so
+// cycling through the displays is quick) are constructed at any one time. The neighbors are
+// constructed on a background thread.
+class AudioDisplayRegistry
+{
+public:
+   // 'frameSize' 0 means the display's default frame size.
+   typedef std::function<AudioDisplayBase*(size_t numLeds, size_t frameSize)> tFactory;
+
+   // The displays that are cycled through use all 'numLeds' LEDs.
+   AudioDisplayRegistry(size_t numLeds);
+   virtual ~AudioDisplayRegistry();
+
+   // Add a display type.
+   void registerDisplay(const std::string& name, tFactory factory);
+
+   // Construct a display by name (e.g. for part of the strip). Returns nullptr for unknown names.
+   AudioDisplayBase* createDisplay(const std::string& name, size_t numLeds, size_t frameSize = 0);
+
+   // Set which displays to cycle through (by name), call after registering the displays. Unknown
+   // names are skipped. If none of the names are known, all the registered displays are used
+   // (in the order they were registered).
+   void setDisplayList(const std::vector<std::string>& names);
+
+   int getNumDisplays();
+   int getActiveIndex();
+
+   // Make 'index' the active display. It is constructed right away if it hasn't been pre-warmed.
+   void setActiveDisplay(int index);
+
+   // The caller's copy keeps the display alive, even if the active display changes.
+   std::shared_ptr<AudioDisplayBase> getActiveDisplay();
+
+private:
+   // Make uncopyable
+   AudioDisplayRegistry(AudioDisplayRegistry const&);
+   void operator=(AudioDisplayRegistry const&);
+
+   size_t m_numLeds;
+   std::vector<std::string> m_registeredNames; // Registration order.
+   std::map<std::string, tFactory> m_factories;
+
+   std::vector<tFactory> m_displayFactories; // One per entry in the display list.
+   std::vector<std::shared_ptr<AudioDisplayBase>> m_displays; // nullptr if not constructed.
+   int m_activeIndex = 0;
+
+   std::mutex m_mutex;
+
+   // Pre-warm Thread Stuff.
+   std::thread m_prewarm_thread;
+   std::condition_variable m_prewarm_condVar;
+   bool m_prewarm_pending = false;
+   bool m_prewarm_active = true;
+   void prewarmFunc();
+
+   bool isNeighbor(int index);
+};
@@ -0,0 +1,148 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <string.h>
+#include <algorithm>
+#include "AudioDisplaySpectrogram.h"
+
+AudioDisplaySpectrogram::AudioDisplaySpectrogram(std::shared_ptr<SpectralAnalysis::Spectrum> spectrum, size_t frameSize, size_t width, size_t height, bool serpentine, float startFreq, float stopFreq, eBandSpacing bandSpacing):
+   AudioDisplayBase(frameSize, width * height),
+   m_width(width),
+   m_height(height),
+   m_xyToLed(width * height),
+   m_spectrum(spectrum),
+   m_fftModified(width),
+   m_history(width * height, 0),
+   m_renderHistory(width * height, 0),
+   m_rowLutIndex(width)
+{
+   // XY mapping. Row 0 (the newest row) is the first row of the matrix.
+   for(size_t y = 0; y < m_height; ++y)
+   {
+      bool reversed = serpentine && (y & 1);
+      for(size_t x = 0; x < m_width; ++x)
+         m_xyToLed[y * m_width + x] = y * m_width + (reversed ? (m_width - 1 - x) : x);
+   }
+
+   // FFT Stuff (one band per column).
+   tFftModifiers mod;
+   mod.startFreq = startFreq;
+   mod.stopFreq = stopFreq;
+   mod.bandSpacing = bandSpacing;
+   mod.clipMin = 0;
+   mod.clipMax = 5000;
+   mod.logScale = false;
+   mod.attenLowStartLevel = 0.2;
+   mod.attenLowStopFreq = 6000;
+   mod.attenLowFreqs = stopFreq > mod.attenLowStopFreq;
+   mod.attackMs = 0;
+   mod.releaseMs = 60; // Short, the history already shows how the bands decay.
+   m_fftModifier.reset(new FftModifier(spectrum->getBinFreqs(), m_width, mod));
+
+   // Only compute the part of the spectrum that is actually displayed (if that is cheaper).
+   int firstBin, numBins;
+   m_fftModifier->getUsedBins(firstBin, numBins);
+   m_usedBins.reset(new SpectralAnalysis::Spectrum::UsedBins(spectrum, firstBin, numBins));
+}
+
+void AudioDisplaySpectrogram::getSpectra(SpectralAnalysis::tSpectrumList& spectra)
+{
+   spectra.push_back(m_spectrum.get());
+}
+
+bool AudioDisplaySpectrogram::processPcm(const SpecAnLedTypes::tPcmSample* samples)
+{
+   // The FFT has already been run by the shared analysis stage. Add a row every update (so the
+   // scroll rate is constant) once there is a spectrum to show.
+   return m_spectrum->getPower() != nullptr;
+}
+
+void AudioDisplaySpectrogram::updateDisplayPoints(int gain, double time)
+{
+   // Modify the latest spectrum (the envelope still needs to run if there isn't a new spectrum).
+   m_fftModifier->modifyPower(m_spectrum->getPower()->data(), m_fftModified.data(), m_spectrum->getResultTime());
+
+   // Add the new row (just move the head, no need to move the older rows).
+   gain *= 6;
+   std::unique_lock<std::mutex> lock(m_historyMutex);
+   m_head = (m_head + m_height - 1) % m_height;
+   ++m_numRowsAdded;
+   uint16_t* row = &m_history[m_head * m_width];
+   for(size_t x = 0; x < m_width; ++x)
+   {
+      int32_t val = (int32_t)m_fftModified[x] * gain;
+      row[x] = std::min(val, int32_t(0xFFFF));
+   }
+}
+
+void AudioDisplaySpectrogram::renderLeds(SpecAnLedTypes::tRgbColor* ledColors, size_t numLeds, float brightness, double time)
+{
+   // Grab a copy of the history so the lock isn't held while filling in the LEDs. Rows don't change
+   // once they are added, so only the rows added since the last render need to be copied.
+   size_t head;
+   {
+      std::unique_lock<std::mutex> lock(m_historyMutex);
+      head = m_head;
+      size_t numNewRows = std::min(m_numRowsAdded - m_numRowsRendered, uint64_t(m_height));
+      for(size_t y = 0; y < numNewRows; ++y)
+      {
+         size_t index = ((head + y) % m_height) * m_width;
+         memcpy(&m_renderHistory[index], &m_history[index], m_width * sizeof(m_history[0]));
+      }
+      m_numRowsRendered = m_numRowsAdded;
+   }
+
+   // Rebuild the color lookup table if the gradient or the brightness changed. Louder is brighter.
+   ++m_renderLedsEpoch; // Odd, the current color scale can't be deleted.
+   uint32_t colorScaleVersion = m_colorScaleVersion;
+   auto colorScale = m_colorScale.load();
+   if(colorScale == nullptr)
+   {
+      // No gradient yet.
+      ++m_renderLedsEpoch;
+      for(size_t i = 0; i < numLeds; ++i)
+         ledColors[i].u32 = SpecAnLedTypes::COLOR_BLACK;
+      return;
+   }
+   if(colorScaleVersion != m_colorLutVersion || brightness != m_colorLutBrightness)
+   {
+      for(int i = 0; i < COLOR_LUT_SIZE; ++i)
+      {
+         uint16_t value = i * 0x101; // 0 to 0xFFFF
+         m_colorLut[i] = colorScale->getColor(value, brightness * float(value) / float(0xFFFF));
+      }
+      m_colorLutVersion = colorScaleVersion;
+      m_colorLutBrightness = brightness;
+   }
+   ++m_renderLedsEpoch; // Even, done with the color scale.
+
+   // Fill in one row at a time, newest row first.
+   size_t numRows = std::min(m_height, numLeds / m_width);
+   for(size_t y = 0; y < numRows; ++y)
+   {
+      const uint16_t* row = &m_renderHistory[((head + y) % m_height) * m_width];
+      for(size_t x = 0; x < m_width; ++x)
+         m_rowLutIndex[x] = row[x] >> 8;
+
+      const uint32_t* xyToLed = &m_xyToLed[y * m_width];
+      for(size_t x = 0; x < m_width; ++x)
+         ledColors[xyToLed[x]] = m_colorLut[m_rowLutIndex[x]];
+   }
+   for(size_t i = numRows * m_width; i < numLeds; ++i)
+      ledColors[i].u32 = SpecAnLedTypes::COLOR_BLACK;
+}
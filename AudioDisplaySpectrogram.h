@@ -0,0 +1,74 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <memory>
+#include <mutex>
+#include "AudioDisplayBase.h"
+#include "spectralAnalysis.h"
+#include "fftModifier.h"
+
+// Scrolling spectrogram (waterfall) for a 2D LED matrix. Each display update adds a row of bands
+// at the top of the matrix and the older rows move down. The rows are kept in a circular buffer,
+// so scrolling just moves the head row.
+class AudioDisplaySpectrogram : public AudioDisplayBase
+{
+public:
+   // 'serpentine' means every other row of the matrix is wired in the opposite direction.
+   AudioDisplaySpectrogram(std::shared_ptr<SpectralAnalysis::Spectrum> spectrum, size_t frameSize, size_t width, size_t height, bool serpentine, float startFreq = 300, float stopFreq = 12000, eBandSpacing bandSpacing = E_BAND_SPACING_LOG);
+
+   void getSpectra(SpectralAnalysis::tSpectrumList& spectra) override;
+
+   void updateDisplayPoints(int gain, double time) override;
+
+   void renderLeds(SpecAnLedTypes::tRgbColor* ledColors, size_t numLeds, float brightness, double time) override;
+
+private:
+   // Make uncopyable
+   AudioDisplaySpectrogram();
+   AudioDisplaySpectrogram(AudioDisplaySpectrogram const&);
+   void operator=(AudioDisplaySpectrogram const&);
+
+   bool processPcm(const SpecAnLedTypes::tPcmSample* samples) override;
+   void fillInDisplayPoints(int gain) override {}
+
+   size_t m_width;
+   size_t m_height;
+   std::vector<uint32_t> m_xyToLed; // Row major, row 0 is the newest row.
+
+   // FFT Stuff
+   std::shared_ptr<const SpectralAnalysis::Spectrum> m_spectrum; // Shared with other displays.
+   std::unique_ptr<FftModifier> m_fftModifier;
+   std::unique_ptr<SpectralAnalysis::Spectrum::UsedBins> m_usedBins;
+   std::vector<uint16_t> m_fftModified; // FFT result after FftModifier
+
+   // History of rows (circular buffer).
+   std::vector<uint16_t> m_history;
+   size_t m_head = 0; // The newest row.
+   uint64_t m_numRowsAdded = 0;
+   std::mutex m_historyMutex;
+   std::vector<uint16_t> m_renderHistory; // Copy of the history (only used by renderLeds).
+   uint64_t m_numRowsRendered = 0; // m_numRowsAdded as of the last copy to m_renderHistory.
+
+   // Color of each value (top 8 bits of the value), rebuilt when the color scale or brightness changes.
+   static const int COLOR_LUT_SIZE = 256;
+   SpecAnLedTypes::tRgbColor m_colorLut[COLOR_LUT_SIZE];
+   uint32_t m_colorLutVersion = 0;
+   float m_colorLutBrightness = -1.0f;
+   std::vector<uint8_t> m_rowLutIndex; // The LUT index of each column in one row.
+};
@@ -0,0 +1,104 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <assert.h>
+#include <algorithm>
+#include <thread>
+#include "AudioDisplayZones.h"
+
+AudioDisplayZones::AudioDisplayZones(size_t frameSize, size_t numLeds):
+   AudioDisplayBase(frameSize, numLeds),
+   m_numLeds(numLeds)
+{
+}
+
+AudioDisplayZones::~AudioDisplayZones()
+{
+}
+
+void AudioDisplayZones::addZone(AudioDisplayBase* display, size_t numLeds, float gain, const ColorGradient::tGradient& gradient)
+{
+   assert(display->getFrameSize() == m_frameSize);
+   numLeds = std::min(numLeds, m_numLeds - m_numZoneLeds);
+
+   m_zones.resize(m_zones.size()+1);
+   auto& zone = m_zones.back();
+   zone.display.reset(display);
+   zone.firstLed = m_numZoneLeds;
+   zone.numLeds = numLeds;
+   zone.gain = gain;
+   zone.gradient = gradient;
+   if(zone.gradient.size() > 0)
+      zone.display->setGradient(zone.gradient, false);
+   m_numZoneLeds += numLeds;
+
+   // One worker thread per zone (other than the first zone, which runs on the calling thread), up to the number of cores.
+   int numThreads = std::min(int(m_zones.size()), int(std::thread::hardware_concurrency())) - 1;
+   if(numThreads > 0 && (m_workers == nullptr || m_workers->getNumThreads() != numThreads))
+      m_workers.reset(new WorkerPool(numThreads, "DisplayZone"));
+}
+
+void AudioDisplayZones::setGradient(ColorGradient::tGradient& gradient, bool reverseGrad)
+{
+   for(auto& zone : m_zones)
+      zone.display->setGradient(zone.gradient.size() > 0 ? zone.gradient : gradient, reverseGrad);
+}
+
+void AudioDisplayZones::getSpectra(SpectralAnalysis::tSpectrumList& spectra)
+{
+   for(auto& zone : m_zones)
+      zone.display->getSpectra(spectra);
+}
+
+bool AudioDisplayZones::processPcm(const SpecAnLedTypes::tPcmSample* samples)
+{
+   // Update the LEDs when any of the zones has something new to display. The other zones just redisplay their last values.
+   bool newValues = false;
+   for(auto& zone : m_zones)
+      newValues = zone.display->parsePcm(samples, m_frameSize) || newValues;
+   return newValues;
+}
+
+void AudioDisplayZones::updateDisplayPoints(int gain, double time)
+{
+   for(auto& zone : m_zones)
+      zone.display->updateDisplayPoints(int(gain * zone.gain), time);
+}
+
+void AudioDisplayZones::renderLeds(SpecAnLedTypes::tRgbColor* ledColors, size_t numLeds, float brightness, double time)
+{
+   numLeds = std::min(numLeds, m_numLeds);
+   auto renderZone = [&](int zoneIndex)
+   {
+      auto& zone = m_zones[zoneIndex];
+      if(zone.firstLed + zone.numLeds <= numLeds)
+         zone.display->renderLeds(ledColors + zone.firstLed, zone.numLeds, brightness, time);
+   };
+   if(m_workers)
+   {
+      m_workers->run(m_zones.size(), renderZone);
+   }
+   else
+   {
+      for(size_t i = 0; i < m_zones.size(); ++i)
+         renderZone(i);
+   }
+
+   for(size_t i = m_numZoneLeds; i < numLeds; ++i)
+      ledColors[i].u32 = SpecAnLedTypes::COLOR_BLACK;
+}
@@ -0,0 +1,71 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+#include <memory>
+#include "AudioDisplayBase.h"
+#include "workerPool.h"
+
+// Splits the LED strip into zones, each with its own Audio Display, gain and (optionally) its own
+// gradient. The zones are rendered concurrently, each into its own part of the LED buffer.
+class AudioDisplayZones : public AudioDisplayBase
+{
+public:
+   AudioDisplayZones(size_t frameSize, size_t numLeds);
+   virtual ~AudioDisplayZones();
+
+   // Add the next zone of 'numLeds' LEDs (zones are in order along the strip). The display's
+   // frame size must match this display's frame size. 'gain' scales the gain knob value. An
+   // empty 'gradient' means the zone uses the current gradient.
+   void addZone(AudioDisplayBase* display, size_t numLeds, float gain, const ColorGradient::tGradient& gradient);
+
+   void setGradient(ColorGradient::tGradient& gradient, bool reverseGrad) override;
+
+   void getSpectra(SpectralAnalysis::tSpectrumList& spectra) override;
+
+   void updateDisplayPoints(int gain, double time) override;
+
+   void renderLeds(SpecAnLedTypes::tRgbColor* ledColors, size_t numLeds, float brightness, double time) override;
+
+private:
+   // Make uncopyable
+   AudioDisplayZones();
+   AudioDisplayZones(AudioDisplayZones const&);
+   void operator=(AudioDisplayZones const&);
+
+   bool processPcm(const SpecAnLedTypes::tPcmSample* samples) override;
+   void fillInDisplayPoints(int gain) override {}
+
+   typedef struct
+   {
+      std::unique_ptr<AudioDisplayBase> display;
+      size_t firstLed;
+      size_t numLeds;
+      float gain;
+      ColorGradient::tGradient gradient; // Empty if the zone uses the current gradient.
+   }tZone;
+
+   std::vector<tZone> m_zones;
+   size_t m_numLeds;
+   size_t m_numZoneLeds = 0; // LEDs after the last zone are black.
+
+   std::unique_ptr<WorkerPool> m_workers;
+};
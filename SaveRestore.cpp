@@ -1,518 +1,737 @@
-/* Copyright 2020, 2022 - 2023 Dan Williams. All Rights Reserved.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy of this
- * software and associated documentation files (the "Software"), to deal in the Software
- * without restriction, including without limitation the rights to use, copy, modify, merge,
- * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
- * to whom the Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all copies or
- * substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
- * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
- * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
- * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
- * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-#include <stdio.h>
-#include <iostream>
-#include <fstream>
-#include <sstream>
-#include <assert.h>
-#include <algorithm>
-#include "SaveRestore.h"
-
-
-static ColorGradient::tGradient jsonToGrad(Json::Value& jsonIn)
-{
-   ColorGradient::tGradient retVal;
-   ColorGradient::tGradientPoint point;
-
-   for(auto pointItr = jsonIn.begin(); pointItr != jsonIn.end(); ++pointItr)
-   {
-      point.hue = (*pointItr)["hue"].asFloat();
-      point.saturation = (*pointItr)["saturation"].asFloat();
-      point.lightness = (*pointItr)["lightness"].asFloat();
-      point.position = (*pointItr)["position"].asFloat();
-      point.reach = (*pointItr)["reach"].asFloat();
-      retVal.push_back(point);
-   }
-
-   return retVal;
-}
-
-static std::vector<ColorGradient::tGradient> jsonToGradVect(Json::Value& jsonIn)
-{
-   std::vector<ColorGradient::tGradient> retVal;
-
-   for(auto gradItr = jsonIn.begin(); gradItr != jsonIn.end(); ++gradItr)
-   {
-      retVal.push_back(jsonToGrad(*gradItr));
-   }
-
-   return retVal;
-}
-
-
-static Json::Value gradToJson(ColorGradient::tGradient& gradIn)
-{
-   Json::Value retVal;
-   for(size_t i = 0; i < gradIn.size(); ++i)
-   {
-      Json::Value point;
-      point["hue"] = gradIn[i].hue;
-      point["saturation"] = gradIn[i].saturation;
-      point["lightness"] = gradIn[i].lightness;
-      point["position"] = gradIn[i].position;
-      point["reach"] = gradIn[i].reach;
-
-      retVal[std::to_string(i)] = point;
-   }
-   return retVal;
-}
-
-static Json::Value gradVectToJson(std::vector<ColorGradient::tGradient>& gradsIn)
-{
-   Json::Value retVal;
-   for(size_t i = 0; i < gradsIn.size(); ++i)
-   {
-      retVal[std::to_string(i)] = gradToJson(gradsIn[i]);
-   }
-   return retVal;
-}
-
-//---------------------------------------------------------------------------------------------------------------------
-//---------------------------------------------------------------------------------------------------------------------
-//---------------------------------------------------------------------------------------------------------------------
-//---------------------------------------------------------------------------------------------------------------------
-//---------------------------------------------------------------------------------------------------------------------
-
-SaveRestoreJson::SaveRestoreJson()
-{
-}
-
-unsigned SaveRestoreJson::restore_numLeds()
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   Json::Value settingsJson;
-   getJson(SETTINGS_JSON, settingsJson);
-
-   int retVal = settingsJson["num_leds"].asInt();
-   if(retVal < 0)
-      retVal = 0;
-   return unsigned(retVal);
-}
-
-bool SaveRestoreJson::restore_mirrorLedMode()
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   Json::Value settingsJson;
-   getJson(SETTINGS_JSON, settingsJson);
-
-   return settingsJson["mirror_led_mode"].asBool();
-}
-
-void SaveRestoreJson::save_gradient(ColorGradient::tGradient& gradToSave)
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   int currentIndex;
-   auto existingGrads = getAllGradients(currentIndex);
-
-   // Check if this gradient already exists (i.e. we don't want duplicates).
-   bool gradExists = false;
-   for(size_t i = 0; i < existingGrads.size(); ++i)
-   {
-      if(match(existingGrads[i], gradToSave))
-      {
-         gradExists = true;
-         currentIndex = i;
-         break;
-      }
-   }
-
-   // Read the settings json file.
-   Json::Value settingsJson;
-   getJson(SETTINGS_JSON, settingsJson);
-
-   if(!gradExists)
-   {
-      // Add the new gradient to the end.
-      auto userGrads = getUserGradients(settingsJson); // Just the user specified gradients.
-      userGrads.push_back(gradToSave);
-
-      // Update settings json with the new gradient.
-      settingsJson["user"] = gradVectToJson(userGrads);
-      settingsJson["grad_index"] = existingGrads.size(); // New one is being added to the end, so old size is the correct index.
-   }
-   else
-   {
-      settingsJson["grad_index"] = currentIndex; // Make sure the index matches the gradient that matches the one passed in.
-   }
-
-   saveSettings(settingsJson); // Save off the changes.
-}
-
-bool SaveRestoreJson::match(ColorGradient::tGradient& comp1, ColorGradient::tGradient& comp2)
-{
-   bool retVal = false;
-   if(comp1.size() == comp2.size())
-   {
-      retVal = true;
-      for(size_t i = 0; i < comp1.size(); ++i)
-      {
-         if(comp1[i] != comp2[i])
-         {
-            retVal = false;
-            break;
-         }
-      }
-   }
-   return retVal;
-}
-
-ColorGradient::tGradient SaveRestoreJson::restore_gradient()
-{
-   return restoreGradient(0);
-}
-
-ColorGradient::tGradient SaveRestoreJson::restore_gradientNext()
-{
-   return restoreGradient(1);
-}
-
-ColorGradient::tGradient SaveRestoreJson::restore_gradientPrev()
-{
-   return restoreGradient(-1);
-}
-
-ColorGradient::tGradient SaveRestoreJson::restoreGradient(int indexDelta)
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   ColorGradient::tGradient retVal;
-   int currentIndex = 0;
-   auto existingGrads = getAllGradients(currentIndex);
-   int existingGradsSize = existingGrads.size();
-
-   if(existingGradsSize > 0)
-   {
-      // Update currentIndex and bound.
-      currentIndex += indexDelta;
-      if(currentIndex >= existingGradsSize)
-         currentIndex = 0;
-      else if(currentIndex < 0)
-         currentIndex = existingGradsSize-1;
-
-      // Return the gradient.
-      retVal = existingGrads[currentIndex];
-
-      // Save the index to this gradient.
-      Json::Value settingsJson;
-      getJson(SETTINGS_JSON, settingsJson);
-      saveGradientIndex(settingsJson, currentIndex);
-   }
-   return retVal;
-}
-
-ColorGradient::tGradient SaveRestoreJson::delete_gradient()
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   int currentIndex = 0;
-   int numPresetGrads = 0;
-   auto existingGrads = getAllGradients(currentIndex, numPresetGrads);
-   int numExistings = existingGrads.size();
-
-   // Will be modifing the settings Json. Read it out here.
-   Json::Value settingsJson;
-   getJson(SETTINGS_JSON, settingsJson);
-
-   int toDeleteIndex = currentIndex - numPresetGrads; // Convert to index in the user specified gradients.
-   if(toDeleteIndex >= 0)
-   {
-      auto userGrads = getUserGradients(settingsJson); // Just the user specified gradients.
-
-      if(int(userGrads.size()) > toDeleteIndex)
-      {
-         userGrads.erase(userGrads.begin() + toDeleteIndex);
-         
-         // Update to account for removed user gradient.
-         numExistings--;
-         settingsJson["user"] = gradVectToJson(userGrads);
-      }
-   }
-
-   // Save off the new index and the updated user gradients (if one was actually removed).
-   currentIndex--;
-   if(currentIndex < 0)
-      currentIndex = numExistings-1;
-   saveGradientIndex(settingsJson, currentIndex); // Will save the index and the updated user gradients.
-
-   // Return the previous gradient.
-   ColorGradient::tGradient retVal;
-   if(numExistings > 0 && currentIndex >= 0 && currentIndex < numExistings)
-      retVal = existingGrads[currentIndex];
-   return retVal;
-}
-
-void SaveRestoreJson::saveGradientIndex(Json::Value& settingsJson, int index)
-{
-   settingsJson["grad_index"] = index;
-   saveSettings(settingsJson);
-}
-
-void SaveRestoreJson::saveSettings(Json::Value& settingsJson)
-{
-   std::ofstream writeFile;
-   writeFile.open(SETTINGS_JSON);
-   writeFile << settingsJson << std::endl;
-   writeFile.close();
-}
-
-
-void SaveRestoreJson::getJson(std::string pathToJson, Json::Value& jsonRetVal)
-{
-   std::ifstream inFile(pathToJson, std::ifstream::binary);
-   Json::Value presetJson;
-   try
-   {
-      inFile >> jsonRetVal;
-   }
-   catch(const std::exception& e)
-   {
-      //std::cerr << e.what() << '\n';
-   }
-   
-}
-
-std::vector<ColorGradient::tGradient> SaveRestoreJson::getAllGradients(int& currentIndex)
-{
-   int numPresetGrads = 0; // dummy
-   return getAllGradients(currentIndex, numPresetGrads);
-}
-
-std::vector<ColorGradient::tGradient> SaveRestoreJson::getAllGradients(int& currentIndex, int& numPresetGrads)
-{
-   Json::Value presetJson;
-   getJson(PRESET_GRADIENT_JSON, presetJson);
-   auto presetGrads = jsonToGradVect(presetJson);
-   numPresetGrads = presetGrads.size();
-
-   Json::Value settingsJson;
-   getJson(SETTINGS_JSON, settingsJson);
-   auto userGrads = getUserGradients(settingsJson);
-
-   currentIndex = settingsJson["grad_index"].asInt();
-
-   std::vector<ColorGradient::tGradient> allGrads;
-   allGrads.insert(allGrads.end(), presetGrads.begin(), presetGrads.end());
-   allGrads.insert(allGrads.end(), userGrads.begin(), userGrads.end());
-
-   return allGrads;
-}
-
-
-std::vector<ColorGradient::tGradient> SaveRestoreJson::getUserGradients(Json::Value& settingsJson)
-{
-   return jsonToGradVect(settingsJson["user"]);;
-}
-
-void SaveRestoreJson::save_displayIndex(int index)
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   Json::Value settingsJson;
-   getJson(SETTINGS_JSON, settingsJson);
-   settingsJson["display_index"] = index;
-   saveSettings(settingsJson);
-}
-
-int SaveRestoreJson::restore_displayIndex()
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   Json::Value settingsJson;
-   getJson(SETTINGS_JSON, settingsJson);
-
-   int retVal = settingsJson["display_index"].asInt();
-   return retVal;
-}
-
-void SaveRestoreJson::save_gradientReverse(bool reversed)
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   Json::Value settingsJson;
-   getJson(SETTINGS_JSON, settingsJson);
-   settingsJson["grad_reverse"] = (reversed ? "true" : "false");
-   saveSettings(settingsJson);
-}
-
-bool SaveRestoreJson::restore_gradientReverse()
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   Json::Value settingsJson;
-   getJson(SETTINGS_JSON, settingsJson);
-
-   bool retVal = false;
-   try
-   {
-      if(settingsJson["grad_reverse"].asString() == "true")
-      {
-         retVal = true;
-      }
-   }
-   catch(const std::exception& e)
-   {
-      //std::cerr << e.what() << '\n';
-   }
-   return retVal;
-}
-
-void SaveRestoreJson::save_remoteLocal(eRemoteLocalOptions remoteLocal)
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   Json::Value settingsJson;
-   getJson(SETTINGS_JSON, settingsJson);
-   std::string jsonStr = "";
-   switch(remoteLocal)
-   {
-      // Fall through is intended.
-      default:
-      case E_DEFAULT:
-         jsonStr = "default";
-      break;
-      case E_LOCAL:
-         jsonStr = "local";
-      break;
-      case E_REMOTE:
-         jsonStr = "remote";
-      break;
-   }
-   settingsJson["remote_local"] = jsonStr;
-   saveSettings(settingsJson);
-}
-
-SaveRestoreJson::eRemoteLocalOptions SaveRestoreJson::restore_remoteLocal()
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   Json::Value settingsJson;
-   getJson(SETTINGS_JSON, settingsJson);
-
-   eRemoteLocalOptions retVal = E_DEFAULT;
-   try
-   {
-      std::string remoteLocalStr = settingsJson["remote_local"].asString();
-      if(remoteLocalStr == "local")
-      {
-         retVal = E_LOCAL;
-      }
-      else if(remoteLocalStr == "remote")
-      {
-         retVal = E_REMOTE;
-      }
-   }
-   catch(const std::exception& e)
-   {
-      //std::cerr << e.what() << '\n';
-   }
-   return retVal;
-}
-
-
-void SaveRestoreJson::save_gain(float gain)
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   if(gain != m_lastGainVal)
-   {
-      Json::Value settingsJson;
-      getJson(SETTINGS_JSON, settingsJson);
-      settingsJson["gain_value"] = gain;
-      m_lastGainVal = gain; // Store off this value so we don't have to read it from the file system next time.
-      saveSettings(settingsJson);
-   }
-}
-
-float SaveRestoreJson::restore_gain()
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-   
-   float retVal = m_lastGainVal;
-   if(retVal < 0) // Check if m_lastGainVal has been set to a valid value.
-   {
-      Json::Value settingsJson;
-      getJson(SETTINGS_JSON, settingsJson);
-
-      if(settingsJson.isMember("gain_value"))
-      {
-         retVal = settingsJson["gain_value"].asFloat();
-         m_lastGainVal = retVal; // Store off this value so we don't have to read it from the file system next time.
-      }
-      else
-         retVal = 100.0; // Max Gain
-
-   }
-   return retVal;
-}
-
-void SaveRestoreJson::save_brightness(float brightness)
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   if(brightness != m_lastBrightVal)
-   {
-      Json::Value settingsJson;
-      getJson(SETTINGS_JSON, settingsJson);
-      settingsJson["brightness_value"] = brightness;
-      m_lastBrightVal = brightness; // Store off this value so we don't have to read it from the file system next time.
-      saveSettings(settingsJson);
-   }
-}
-
-float SaveRestoreJson::restore_brightness()
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   float retVal = m_lastBrightVal;
-   if(retVal < 0) // Check if m_lastBrightVal has been set to a valid value.
-   {
-      Json::Value settingsJson;
-      getJson(SETTINGS_JSON, settingsJson);
-
-      if(settingsJson.isMember("brightness_value"))
-      {
-         retVal = settingsJson["brightness_value"].asFloat();
-         m_lastBrightVal = retVal; // Store off this value so we don't have to read it from the file system next time.
-      }
-      else
-         retVal = 0.10; // 10% Brightness
-
-   }
-   return retVal;
-}
-
-std::string SaveRestoreJson::restore_microphoneName()
-{
-   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
-
-   std::string retVal = "hw:1"; // default
-
-   Json::Value settingsJson;
-   getJson(SETTINGS_JSON, settingsJson);
-
-   if(settingsJson.isMember("microphone_name"))
-   {
-      retVal = settingsJson["microphone_name"].asString();
-   }
-
-   return retVal;
-}
+/* Copyright 2020, 2022 - 2023 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <assert.h>
+#include <algorithm>
+#include "SaveRestore.h"
+
+
+static ColorGradient::tGradient jsonToGrad(Json::Value& jsonIn)
+{
+   ColorGradient::tGradient retVal;
+   ColorGradient::tGradientPoint point;
+
+   for(auto pointItr = jsonIn.begin(); pointItr != jsonIn.end(); ++pointItr)
+   {
+      point.hue = (*pointItr)["hue"].asFloat();
+      point.saturation = (*pointItr)["saturation"].asFloat();
+      point.lightness = (*pointItr)["lightness"].asFloat();
+      point.position = (*pointItr)["position"].asFloat();
+      point.reach = (*pointItr)["reach"].asFloat();
+      retVal.push_back(point);
+   }
+
+   return retVal;
+}
+
+static std::vector<ColorGradient::tGradient> jsonToGradVect(Json::Value& jsonIn)
+{
+   std::vector<ColorGradient::tGradient> retVal;
+
+   for(auto gradItr = jsonIn.begin(); gradItr != jsonIn.end(); ++gradItr)
+   {
+      retVal.push_back(jsonToGrad(*gradItr));
+   }
+
+   return retVal;
+}
+
+
+static Json::Value gradToJson(ColorGradient::tGradient& gradIn)
+{
+   Json::Value retVal;
+   for(size_t i = 0; i < gradIn.size(); ++i)
+   {
+      Json::Value point;
+      point["hue"] = gradIn[i].hue;
+      point["saturation"] = gradIn[i].saturation;
+      point["lightness"] = gradIn[i].lightness;
+      point["position"] = gradIn[i].position;
+      point["reach"] = gradIn[i].reach;
+
+      retVal[std::to_string(i)] = point;
+   }
+   return retVal;
+}
+
+static Json::Value gradVectToJson(std::vector<ColorGradient::tGradient>& gradsIn)
+{
+   Json::Value retVal;
+   for(size_t i = 0; i < gradsIn.size(); ++i)
+   {
+      retVal[std::to_string(i)] = gradToJson(gradsIn[i]);
+   }
+   return retVal;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+//---------------------------------------------------------------------------------------------------------------------
+//---------------------------------------------------------------------------------------------------------------------
+//---------------------------------------------------------------------------------------------------------------------
+//---------------------------------------------------------------------------------------------------------------------
+
+SaveRestoreJson::SaveRestoreJson()
+{
+}
+
+unsigned SaveRestoreJson::restore_numLeds()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   int retVal = settingsJson["num_leds"].asInt();
+   if(retVal < 0)
+      retVal = 0;
+   return unsigned(retVal);
+}
+
+bool SaveRestoreJson::restore_mirrorLedMode()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   return settingsJson["mirror_led_mode"].asBool();
+}
+
+void SaveRestoreJson::save_gradient(ColorGradient::tGradient& gradToSave)
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   int currentIndex;
+   auto existingGrads = getAllGradients(currentIndex);
+
+   // Check if this gradient already exists (i.e. we don't want duplicates).
+   bool gradExists = false;
+   for(size_t i = 0; i < existingGrads.size(); ++i)
+   {
+      if(match(existingGrads[i], gradToSave))
+      {
+         gradExists = true;
+         currentIndex = i;
+         break;
+      }
+   }
+
+   // Read the settings json file.
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   if(!gradExists)
+   {
+      // Add the new gradient to the end.
+      auto userGrads = getUserGradients(settingsJson); // Just the user specified gradients.
+      userGrads.push_back(gradToSave);
+
+      // Update settings json with the new gradient.
+      settingsJson["user"] = gradVectToJson(userGrads);
+      settingsJson["grad_index"] = existingGrads.size(); // New one is being added to the end, so old size is the correct index.
+   }
+   else
+   {
+      settingsJson["grad_index"] = currentIndex; // Make sure the index matches the gradient that matches the one passed in.
+   }
+
+   saveSettings(settingsJson); // Save off the changes.
+}
+
+bool SaveRestoreJson::match(ColorGradient::tGradient& comp1, ColorGradient::tGradient& comp2)
+{
+   bool retVal = false;
+   if(comp1.size() == comp2.size())
+   {
+      retVal = true;
+      for(size_t i = 0; i < comp1.size(); ++i)
+      {
+         if(comp1[i] != comp2[i])
+         {
+            retVal = false;
+            break;
+         }
+      }
+   }
+   return retVal;
+}
+
+ColorGradient::tGradient SaveRestoreJson::restore_gradient()
+{
+   return restoreGradient(0);
+}
+
+ColorGradient::tGradient SaveRestoreJson::restore_gradientNext()
+{
+   return restoreGradient(1);
+}
+
+ColorGradient::tGradient SaveRestoreJson::restore_gradientPrev()
+{
+   return restoreGradient(-1);
+}
+
+ColorGradient::tGradient SaveRestoreJson::restoreGradient(int indexDelta)
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   ColorGradient::tGradient retVal;
+   int currentIndex = 0;
+   auto existingGrads = getAllGradients(currentIndex);
+   int existingGradsSize = existingGrads.size();
+
+   if(existingGradsSize > 0)
+   {
+      // Update currentIndex and bound.
+      currentIndex += indexDelta;
+      if(currentIndex >= existingGradsSize)
+         currentIndex = 0;
+      else if(currentIndex < 0)
+         currentIndex = existingGradsSize-1;
+
+      // Return the gradient.
+      retVal = existingGrads[currentIndex];
+
+      // Save the index to this gradient.
+      Json::Value settingsJson;
+      getJson(SETTINGS_JSON, settingsJson);
+      saveGradientIndex(settingsJson, currentIndex);
+   }
+   return retVal;
+}
+
+ColorGradient::tGradient SaveRestoreJson::delete_gradient()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   int currentIndex = 0;
+   int numPresetGrads = 0;
+   auto existingGrads = getAllGradients(currentIndex, numPresetGrads);
+   int numExistings = existingGrads.size();
+
+   // Will be modifing the settings Json. Read it out here.
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   int toDeleteIndex = currentIndex - numPresetGrads; // Convert to index in the user specified gradients.
+   if(toDeleteIndex >= 0)
+   {
+      auto userGrads = getUserGradients(settingsJson); // Just the user specified gradients.
+
+      if(int(userGrads.size()) > toDeleteIndex)
+      {
+         userGrads.erase(userGrads.begin() + toDeleteIndex);
+         
+         // Update to account for removed user gradient.
+         numExistings--;
+         settingsJson["user"] = gradVectToJson(userGrads);
+      }
+   }
+
+   // Save off the new index and the updated user gradients (if one was actually removed).
+   currentIndex--;
+   if(currentIndex < 0)
+      currentIndex = numExistings-1;
+   saveGradientIndex(settingsJson, currentIndex); // Will save the index and the updated user gradients.
+
+   // Return the previous gradient.
+   ColorGradient::tGradient retVal;
+   if(numExistings > 0 && currentIndex >= 0 && currentIndex < numExistings)
+      retVal = existingGrads[currentIndex];
+   return retVal;
+}
+
+void SaveRestoreJson::saveGradientIndex(Json::Value& settingsJson, int index)
+{
+   settingsJson["grad_index"] = index;
+   saveSettings(settingsJson);
+}
+
+void SaveRestoreJson::saveSettings(Json::Value& settingsJson)
+{
+   std::ofstream writeFile;
+   writeFile.open(SETTINGS_JSON);
+   writeFile << settingsJson << std::endl;
+   writeFile.close();
+}
+
+
+void SaveRestoreJson::getJson(std::string pathToJson, Json::Value& jsonRetVal)
+{
+   std::ifstream inFile(pathToJson, std::ifstream::binary);
+   Json::Value presetJson;
+   try
+   {
+      inFile >> jsonRetVal;
+   }
+   catch(const std::exception& e)
+   {
+      //std::cerr << e.what() << '\n';
+   }
+   
+}
+
+std::vector<ColorGradient::tGradient> SaveRestoreJson::getAllGradients(int& currentIndex)
+{
+   int numPresetGrads = 0; // dummy
+   return getAllGradients(currentIndex, numPresetGrads);
+}
+
+std::vector<ColorGradient::tGradient> SaveRestoreJson::getAllGradients(int& currentIndex, int& numPresetGrads)
+{
+   Json::Value presetJson;
+   getJson(PRESET_GRADIENT_JSON, presetJson);
+   auto presetGrads = jsonToGradVect(presetJson);
+   numPresetGrads = presetGrads.size();
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+   auto userGrads = getUserGradients(settingsJson);
+
+   currentIndex = settingsJson["grad_index"].asInt();
+
+   std::vector<ColorGradient::tGradient> allGrads;
+   allGrads.insert(allGrads.end(), presetGrads.begin(), presetGrads.end());
+   allGrads.insert(allGrads.end(), userGrads.begin(), userGrads.end());
+
+   return allGrads;
+}
+
+
+std::vector<ColorGradient::tGradient> SaveRestoreJson::getUserGradients(Json::Value& settingsJson)
+{
+   return jsonToGradVect(settingsJson["user"]);;
+}
+
+void SaveRestoreJson::save_displayIndex(int index)
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+   settingsJson["display_index"] = index;
+   saveSettings(settingsJson);
+}
+
+int SaveRestoreJson::restore_displayIndex()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   int retVal = settingsJson["display_index"].asInt();
+   return retVal;
+}
+
+void SaveRestoreJson::save_gradientReverse(bool reversed)
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+   settingsJson["grad_reverse"] = (reversed ? "true" : "false");
+   saveSettings(settingsJson);
+}
+
+bool SaveRestoreJson::restore_gradientReverse()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   bool retVal = false;
+   try
+   {
+      if(settingsJson["grad_reverse"].asString() == "true")
+      {
+         retVal = true;
+      }
+   }
+   catch(const std::exception& e)
+   {
+      //std::cerr << e.what() << '\n';
+   }
+   return retVal;
+}
+
+void SaveRestoreJson::save_remoteLocal(eRemoteLocalOptions remoteLocal)
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+   std::string jsonStr = "";
+   switch(remoteLocal)
+   {
+      // Fall through is intended.
+      default:
+      case E_DEFAULT:
+         jsonStr = "default";
+      break;
+      case E_LOCAL:
+         jsonStr = "local";
+      break;
+      case E_REMOTE:
+         jsonStr = "remote";
+      break;
+   }
+   settingsJson["remote_local"] = jsonStr;
+   saveSettings(settingsJson);
+}
+
+SaveRestoreJson::eRemoteLocalOptions SaveRestoreJson::restore_remoteLocal()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   eRemoteLocalOptions retVal = E_DEFAULT;
+   try
+   {
+      std::string remoteLocalStr = settingsJson["remote_local"].asString();
+      if(remoteLocalStr == "local")
+      {
+         retVal = E_LOCAL;
+      }
+      else if(remoteLocalStr == "remote")
+      {
+         retVal = E_REMOTE;
+      }
+   }
+   catch(const std::exception& e)
+   {
+      //std::cerr << e.what() << '\n';
+   }
+   return retVal;
+}
+
+
+void SaveRestoreJson::save_gain(float gain)
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   if(gain != m_lastGainVal)
+   {
+      Json::Value settingsJson;
+      getJson(SETTINGS_JSON, settingsJson);
+      settingsJson["gain_value"] = gain;
+      m_lastGainVal = gain; // Store off this value so we don't have to read it from the file system next time.
+      saveSettings(settingsJson);
+   }
+}
+
+float SaveRestoreJson::restore_gain()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+   
+   float retVal = m_lastGainVal;
+   if(retVal < 0) // Check if m_lastGainVal has been set to a valid value.
+   {
+      Json::Value settingsJson;
+      getJson(SETTINGS_JSON, settingsJson);
+
+      if(settingsJson.isMember("gain_value"))
+      {
+         retVal = settingsJson["gain_value"].asFloat();
+         m_lastGainVal = retVal; // Store off this value so we don't have to read it from the file system next time.
+      }
+      else
+         retVal = 100.0; // Max Gain
+
+   }
+   return retVal;
+}
+
+void SaveRestoreJson::save_brightness(float brightness)
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   if(brightness != m_lastBrightVal)
+   {
+      Json::Value settingsJson;
+      getJson(SETTINGS_JSON, settingsJson);
+      settingsJson["brightness_value"] = brightness;
+      m_lastBrightVal = brightness; // Store off this value so we don't have to read it from the file system next time.
+      saveSettings(settingsJson);
+   }
+}
+
+float SaveRestoreJson::restore_brightness()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   float retVal = m_lastBrightVal;
+   if(retVal < 0) // Check if m_lastBrightVal has been set to a valid value.
+   {
+      Json::Value settingsJson;
+      getJson(SETTINGS_JSON, settingsJson);
+
+      if(settingsJson.isMember("brightness_value"))
+      {
+         retVal = settingsJson["brightness_value"].asFloat();
+         m_lastBrightVal = retVal; // Store off this value so we don't have to read it from the file system next time.
+      }
+      else
+         retVal = 0.10; // 10% Brightness
+
+   }
+   return retVal;
+}
+
+std::string SaveRestoreJson::restore_microphoneName()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   std::string retVal = "hw:1"; // default
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   if(settingsJson.isMember("microphone_name"))
+   {
+      retVal = settingsJson["microphone_name"].asString();
+   }
+
+   return retVal;
+}
+
+unsigned SaveRestoreJson::restore_microphoneChannels()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   unsigned retVal = 1; // default (mono)
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   if(settingsJson.isMember("microphone_channels"))
+   {
+      retVal = settingsJson["microphone_channels"].asInt() == 2 ? 2 : 1; // Only mono and stereo are supported.
+   }
+
+   return retVal;
+}
+
+FftBackend::ePrecision SaveRestoreJson::restore_fftPrecision()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   FftBackend::ePrecision retVal = FftBackend::E_PRECISION_FASTEST; // default
+   try
+   {
+      std::string precisionStr = settingsJson["fft_precision"].asString();
+      if(precisionStr == "int16")
+      {
+         retVal = FftBackend::E_PRECISION_INT16;
+      }
+      else if(precisionStr == "int32")
+      {
+         retVal = FftBackend::E_PRECISION_INT32_BFP;
+      }
+      else if(precisionStr == "float")
+      {
+         retVal = FftBackend::E_PRECISION_FLOAT;
+      }
+   }
+   catch(const std::exception& e)
+   {
+      //std::cerr << e.what() << '\n';
+   }
+   return retVal;
+}
+
+WindowTables::eWindow SaveRestoreJson::restore_fftWindow(const std::string& displayName, WindowTables::eWindow defaultWindow)
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   WindowTables::eWindow retVal = defaultWindow;
+   try
+   {
+      // Either one window for all the FFT displays or a window per display name.
+      std::string windowStr;
+      auto& windowJson = settingsJson["fft_window"];
+      if(windowJson.isString())
+         windowStr = windowJson.asString();
+      else if(windowJson.isObject() && windowJson.isMember(displayName))
+         windowStr = windowJson[displayName].asString();
+
+      if(windowStr == "none")
+      {
+         retVal = WindowTables::E_WINDOW_NONE;
+      }
+      else if(windowStr == "hann")
+      {
+         retVal = WindowTables::E_WINDOW_HANN;
+      }
+      else if(windowStr == "blackman")
+      {
+         retVal = WindowTables::E_WINDOW_BLACKMAN;
+      }
+      else if(windowStr == "blackman_harris")
+      {
+         retVal = WindowTables::E_WINDOW_BLACKMAN_HARRIS;
+      }
+      else if(windowStr == "flat_top")
+      {
+         retVal = WindowTables::E_WINDOW_FLAT_TOP;
+      }
+   }
+   catch(const std::exception& e)
+   {
+      //std::cerr << e.what() << '\n';
+   }
+   return retVal;
+}
+
+float SaveRestoreJson::restore_idleTimeout()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   float retVal = 60.0; // default (seconds)
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   if(settingsJson.isMember("idle_timeout_sec"))
+   {
+      retVal = settingsJson["idle_timeout_sec"].asFloat();
+   }
+
+   return retVal;
+}
+
+float SaveRestoreJson::restore_ledRate()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   float retVal = 0.0; // default (refresh the LEDs when the displays update)
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   if(settingsJson.isMember("led_rate_hz"))
+   {
+      retVal = std::max(settingsJson["led_rate_hz"].asFloat(), 0.0f);
+   }
+
+   return retVal;
+}
+
+std::vector<std::string> SaveRestoreJson::restore_displayList()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   std::vector<std::string> retVal; // default (empty, i.e. all the displays)
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   if(settingsJson.isMember("displays") && settingsJson["displays"].isArray())
+   {
+      for(auto& name : settingsJson["displays"])
+         retVal.push_back(name.asString());
+   }
+
+   return retVal;
+}
+
+std::vector<SaveRestoreJson::tZone> SaveRestoreJson::restore_zones()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   std::vector<tZone> retVal; // default (no zones)
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   if(settingsJson.isMember("zones") && settingsJson["zones"].isArray())
+   {
+      for(auto& zoneJson : settingsJson["zones"])
+      {
+         tZone zone;
+         zone.display = zoneJson["display"].asString();
+         zone.numLeds = zoneJson.isMember("num_leds") ? zoneJson["num_leds"].asUInt() : 0;
+         zone.gain = zoneJson.isMember("gain") ? zoneJson["gain"].asFloat() : 1.0;
+         if(zoneJson.isMember("gradient"))
+            zone.gradient = jsonToGrad(zoneJson["gradient"]);
+         retVal.push_back(zone);
+      }
+   }
+
+   return retVal;
+}
+
+SaveRestoreJson::tMatrix SaveRestoreJson::restore_matrix()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   tMatrix retVal = {0, 0, true}; // default (no matrix)
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   if(settingsJson.isMember("matrix_width") && settingsJson.isMember("matrix_height"))
+   {
+      retVal.width = settingsJson["matrix_width"].asUInt();
+      retVal.height = settingsJson["matrix_height"].asUInt();
+      if(settingsJson.isMember("matrix_serpentine"))
+         retVal.serpentine = settingsJson["matrix_serpentine"].asBool();
+   }
+
+   return retVal;
+}
+
+std::vector<LedMap::tSegment> SaveRestoreJson::restore_ledLayout()
+{
+   std::unique_lock<std::mutex> lock(m_mutex); // Lock around all public functions (they will never call each other).
+
+   std::vector<LedMap::tSegment> retVal; // default (LEDs in order)
+
+   Json::Value settingsJson;
+   getJson(SETTINGS_JSON, settingsJson);
+
+   if(settingsJson.isMember("led_layout") && settingsJson["led_layout"].isArray())
+   {
+      for(auto& segmentJson : settingsJson["led_layout"])
+      {
+         LedMap::tSegment segment;
+         segment.start = segmentJson["start"].asUInt();
+         segment.numLeds = segmentJson["num_leds"].asUInt();
+         segment.reverse = segmentJson["reverse"].asBool();
+         segment.rotate = segmentJson["rotate"].asUInt();
+         segment.serpentineWidth = segmentJson["serpentine_width"].asUInt();
+         if(segment.numLeds > 0)
+            retVal.push_back(segment);
+      }
+   }
+
+   return retVal;
+}
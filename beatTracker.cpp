@@ -0,0 +1,226 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <algorithm>
+#include "beatTracker.h"
+#include "fastMath.h"
+
+#define BAND_START_FREQ (30.0f)
+#define BAND_STOP_FREQ (12000.0f)
+#define FLUX_MEAN_SEC (0.5f)      // Flux below its recent average isn't an onset.
+#define ONSET_STATS_SEC (2.0f)    // Time constant of the onset mean / deviation.
+#define ONSET_MAX_SEC (3.0f)      // How fast the onset normalization falls back after a loud onset.
+#define ACF_WINDOW_SEC (6.0f)     // Time constant of the autocorrelation.
+#define TEMPO_CENTER_BPM (120.0f) // Tempos near this are preferred (i.e. not double / half time).
+#define TEMPO_WIDTH_OCTAVES (1.0f)
+#define PERIOD_SMOOTHING (0.1f)   // Fraction of the way the beat period moves to the new estimate per hop.
+#define PEAK_THRESHOLD (3.0f)     // An onset peak must be this many mean deviations above the mean.
+#define MIN_CONFIDENCE (0.2f)     // Below this the beats are just the onset peaks.
+#define COMB_BEATS (4)            // Number of past beats used to line the beats up with the onsets.
+#define PHASE_CORRECTION (0.5f)   // Fraction of the beat time error that is corrected per beat.
+
+static float timeConstCoef(float hopRate, float timeConstSec)
+{
+   return 1.0f - expf(-1.0f / (hopRate * timeConstSec));
+}
+
+BeatTracker::BeatTracker(const std::vector<float>& binFreqs, float hopRate, int numBands, float minBpm, float maxBpm):
+   m_hopRate(hopRate),
+   m_fluxMeanCoef(timeConstCoef(hopRate, FLUX_MEAN_SEC)),
+   m_onsetStatsCoef(timeConstCoef(hopRate, ONSET_STATS_SEC)),
+   m_onsetMaxDecay(1.0f - timeConstCoef(hopRate, ONSET_MAX_SEC)),
+   m_bands(numBands),
+   m_logBands(numBands),
+   m_prevLogBands(numBands),
+   m_minLag(std::max(1, (int)floorf(hopRate * 60.0f / maxBpm))),
+   m_maxLag(std::max(m_minLag + 2, (int)ceilf(hopRate * 60.0f / minBpm))),
+   m_acfDecay(1.0f - timeConstCoef(hopRate, ACF_WINDOW_SEC)),
+   m_acf(m_maxLag + 1, 0.0f),
+   m_tempoWeight(m_maxLag + 1, 0.0f),
+   m_periodSec(60.0f / TEMPO_CENTER_BPM)
+{
+   // Log spaced bands. The full magnitude range is kept (the log is taken after banding).
+   tFftModifiers mod;
+   mod.startFreq = BAND_START_FREQ;
+   mod.stopFreq = std::min(BAND_STOP_FREQ, binFreqs.back());
+   mod.bandSpacing = E_BAND_SPACING_LOG;
+   m_fftModifier.reset(new FftModifier(binFreqs, numBands, mod));
+
+   m_onset.resize(m_maxLag * COMB_BEATS + 1, 0.0f);
+
+   for(int lag = m_minLag; lag <= m_maxLag; ++lag)
+   {
+      float octaves = log2f((m_hopRate * 60.0f / lag) / TEMPO_CENTER_BPM);
+      m_tempoWeight[lag] = expf(-0.5f * (octaves * octaves) / (TEMPO_WIDTH_OCTAVES * TEMPO_WIDTH_OCTAVES));
+   }
+}
+
+BeatTracker::~BeatTracker()
+{
+}
+
+bool BeatTracker::process(const float* power, double resultTime)
+{
+   // Spectral flux (how much the bands went up since the last hop).
+   // The increases of the log magnitudes are used, so loud and quiet bands count the same.
+   int numBands = m_bands.size();
+   m_fftModifier->modifyPower(power, m_bands.data(), resultTime);
+   for(int i = 0; i < numBands; ++i)
+      m_logBands[i] = float(m_bands[i]) + 1.0f;
+   FastMath::log(m_logBands.data(), m_logBands.data(), numBands);
+
+   float flux = 0.0f;
+   if(m_havePrevBands)
+   {
+      for(int i = 0; i < numBands; ++i)
+         flux += std::max(0.0f, m_logBands[i] - m_prevLogBands[i]);
+      flux /= numBands;
+   }
+   m_logBands.swap(m_prevLogBands);
+   m_havePrevBands = true;
+
+   // Onset envelope. Slow changes (e.g. a crescendo) are removed, then the envelope is centered
+   // on its mean so the autocorrelation only sees the onsets.
+   m_fluxMean += m_fluxMeanCoef * (flux - m_fluxMean);
+   float onset = std::max(0.0f, flux - m_fluxMean);
+   m_onsetMean += m_onsetStatsCoef * (onset - m_onsetMean);
+   float centered = onset - m_onsetMean;
+   m_onsetDev += m_onsetStatsCoef * (fabsf(centered) - m_onsetDev);
+
+   m_onsetMax = std::max(onset, m_onsetMax * m_onsetMaxDecay);
+   m_onsetNorm = m_onsetMax > 0.0f ? onset / m_onsetMax : 0.0f;
+
+   m_onsetHead = (m_onsetHead + 1) % m_onset.size();
+   m_onset[m_onsetHead] = centered;
+
+   // Autocorrelation, one multiply per lag (split where the ring buffer wraps, so there is no modulo per lag).
+   const float* onsetRing = m_onset.data();
+   int head = m_onsetHead;
+   int numUnwrapped = std::min(m_maxLag, head) + 1;
+   int lag = 0;
+   for(; lag < numUnwrapped; ++lag)
+      m_acf[lag] = m_acfDecay * m_acf[lag] + centered * onsetRing[head - lag];
+   for(; lag <= m_maxLag; ++lag)
+      m_acf[lag] = m_acfDecay * m_acf[lag] + centered * onsetRing[head - lag + m_onset.size()];
+   updateTempo();
+
+   // Onset peak on the previous hop.
+   float prevOnset = onsetAt(1);
+   bool peak = prevOnset > onsetAt(2) && prevOnset >= centered && prevOnset > PEAK_THRESHOLD * m_onsetDev;
+   double peakTime = resultTime - 1.0 / m_hopRate;
+
+   bool beat = false;
+   if(m_confidence >= MIN_CONFIDENCE)
+   {
+      // Predict the beats from the tempo.
+      if(resultTime >= m_nextBeatTime)
+      {
+         beat = true;
+         m_lastBeatTime = m_nextBeatTime;
+         m_nextBeatTime += m_periodSec;
+         if(m_nextBeatTime <= resultTime)
+            m_nextBeatTime = resultTime + m_periodSec; // Fell behind (e.g. the tempo just changed).
+         alignBeats(resultTime);
+      }
+   }
+   else if(peak && peakTime - m_lastBeatTime >= m_minLag / m_hopRate)
+   {
+      // No steady tempo, every onset peak is a beat.
+      beat = true;
+      m_lastBeatTime = peakTime;
+      m_nextBeatTime = peakTime + m_periodSec;
+   }
+   return beat;
+}
+
+void BeatTracker::updateTempo()
+{
+   if(m_acf[0] <= 0.0f)
+   {
+      m_confidence = 0.0f;
+      return;
+   }
+
+   int bestLag = m_minLag;
+   float bestScore = m_acf[m_minLag] * m_tempoWeight[m_minLag];
+   for(int lag = m_minLag + 1; lag <= m_maxLag; ++lag)
+   {
+      float score = m_acf[lag] * m_tempoWeight[lag];
+      if(score > bestScore)
+      {
+         bestScore = score;
+         bestLag = lag;
+      }
+   }
+   m_confidence = std::min(1.0f, std::max(0.0f, m_acf[bestLag] / m_acf[0]));
+
+   // Parabolic interpolation around the best lag (the tempo isn't a whole number of hops).
+   float lag = bestLag;
+   if(bestLag > m_minLag && bestLag < m_maxLag)
+   {
+      float y0 = m_acf[bestLag-1];
+      float y1 = m_acf[bestLag];
+      float y2 = m_acf[bestLag+1];
+      float denom = y0 - 2.0f * y1 + y2;
+      if(denom < 0.0f)
+         lag += 0.5f * (y0 - y2) / denom;
+   }
+   m_periodSec += PERIOD_SMOOTHING * (lag / m_hopRate - m_periodSec);
+}
+
+void BeatTracker::alignBeats(double time)
+{
+   // Find the beat phase that lines up with the most onset energy over the last few beats (a comb
+   // over the onset envelope), so the beats land on the strongest onsets instead of the off beats.
+   // This only runs once per beat.
+   float periodHops = m_periodSec * m_hopRate;
+   int numOffsets = std::max(1, (int)periodHops);
+   int maxHopsAgo = m_onset.size() - 1;
+   int bestOffset = 0;
+   float bestScore = 0.0f;
+   for(int offset = 0; offset < numOffsets; ++offset)
+   {
+      float score = 0.0f;
+      for(int beat = 0; beat < COMB_BEATS; ++beat)
+      {
+         int hopsAgo = offset + (int)(beat * periodHops + 0.5f);
+         if(hopsAgo <= maxHopsAgo)
+            score += onsetAt(hopsAgo);
+      }
+      if(offset == 0 || score > bestScore)
+      {
+         bestScore = score;
+         bestOffset = offset;
+      }
+   }
+
+   // Move the next beat part of the way towards the comb's phase.
+   double error = (time - bestOffset / m_hopRate) - m_lastBeatTime;
+   error -= m_periodSec * round(error / m_periodSec);
+   m_nextBeatTime += PHASE_CORRECTION * error;
+}
+
+float BeatTracker::getBeatPhase(double time)
+{
+   double period = m_nextBeatTime - m_lastBeatTime;
+   if(period <= 0.0)
+      return 0.0f;
+   double phase = (time - m_lastBeatTime) / period;
+   return phase < 0.0 ? 0.0f : (phase > 1.0 ? 1.0f : (float)phase);
+}
@@ -0,0 +1,90 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <vector>
+#include <memory>
+#include "fftModifier.h"
+
+// Onset and tempo tracking from the FFT power spectrum. Each new spectrum (one hop) is summed into
+// a few log bands, the spectral flux (sum of the band increases) becomes the onset envelope and the
+// tempo comes from an autocorrelation of the envelope that is updated one hop at a time. All the
+// per hop work is O(bands + lags). Beats are predicted from the tempo and pulled towards the onsets.
+class BeatTracker
+{
+public:
+   // 'hopRate' is how often 'process' is called (per second).
+   BeatTracker(const std::vector<float>& binFreqs, float hopRate, int numBands = 16, float minBpm = 60, float maxBpm = 200);
+   virtual ~BeatTracker();
+
+   // Returns true if there is a beat on this hop. 'resultTime' is the time (seconds) of the spectrum.
+   bool process(const float* power, double resultTime);
+
+   // The range of FFT bins that are actually used.
+   void getUsedBins(int& firstBin, int& numBins){m_fftModifier->getUsedBins(firstBin, numBins);}
+
+   float getBpm(){return 60.0f / m_periodSec;}
+   float getConfidence(){return m_confidence;} // 0 to 1 (how periodic the onsets are).
+   float getOnset(){return m_onsetNorm;} // Latest onset strength (0 to 1).
+   float getBeatPhase(double time); // 0 at a beat, rising to 1 at the next beat.
+
+private:
+   // Make uncopyable
+   BeatTracker();
+   BeatTracker(BeatTracker const&);
+   void operator=(BeatTracker const&);
+
+   float m_hopRate;
+   float m_fluxMeanCoef;
+   float m_onsetStatsCoef;
+   float m_onsetMaxDecay;
+
+   // Bands
+   std::unique_ptr<FftModifier> m_fftModifier;
+   std::vector<uint16_t> m_bands;
+   std::vector<float> m_logBands;
+   std::vector<float> m_prevLogBands;
+   bool m_havePrevBands = false;
+
+   // Onset envelope (ring buffer, a few of the longest beats long).
+   std::vector<float> m_onset;
+   size_t m_onsetHead = 0; // Index of the newest value.
+   float m_fluxMean = 0.0f;
+   float m_onsetMean = 0.0f;
+   float m_onsetDev = 0.0f; // Mean absolute deviation.
+   float m_onsetNorm = 0.0f;
+   float m_onsetMax = 0.0f;
+
+   // Autocorrelation of the onset envelope (exponentially weighted), one value per lag.
+   int m_minLag;
+   int m_maxLag;
+   float m_acfDecay;
+   std::vector<float> m_acf; // Index 0 is lag 0 (the envelope energy).
+   std::vector<float> m_tempoWeight; // Per lag, prefers tempos near 120 BPM.
+
+   // Tempo / beats.
+   float m_periodSec;
+   float m_confidence = 0.0f;
+   double m_lastBeatTime = 0.0;
+   double m_nextBeatTime = 0.0;
+
+   float onsetAt(int hopsAgo){return m_onset[(m_onsetHead + m_onset.size() - hopsAgo) % m_onset.size()];}
+   void updateTempo();
+   void alignBeats(double time);
+};
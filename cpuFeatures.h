@@ -0,0 +1,59 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#if defined(__arm__) || defined(__aarch64__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+// Run time checks of what the CPU we are running on supports. This allows a single binary
+// to pick the fastest code path on a Pi Zero (ARMv6, no NEON), a Pi 3/4 or an x86 dev box.
+namespace CpuFeatures
+{
+   static inline bool hasNeon()
+   {
+#if defined(__aarch64__)
+      return true; // NEON (ASIMD) is mandatory on ARMv8.
+#elif defined(__arm__)
+      return (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#else
+      return false;
+#endif
+   }
+
+   static inline bool hasSse2()
+   {
+#if defined(__x86_64__) || defined(__i386__)
+      return __builtin_cpu_supports("sse2");
+#else
+      return false;
+#endif
+   }
+
+   static inline bool hasAvx()
+   {
+#if defined(__x86_64__) || defined(__i386__)
+      return __builtin_cpu_supports("avx");
+#else
+      return false;
+#endif
+   }
+}
+
@@ -0,0 +1,115 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <string.h> // memcpy, memmove
+#include <algorithm> // std::fill
+#include "decimator.h"
+
+// GCC vector extensions compile to NEON / SSE when available and plain C otherwise.
+typedef float v4sf __attribute__((vector_size(16)));
+
+
+Decimator::Decimator(float sampleRate, int decimation, float passBandFreq):
+   m_decimation(decimation),
+   m_phase(0)
+{
+   // Everything above (outputSampleRate - passBandFreq) would alias into the pass band.
+   float outSampleRate = sampleRate / decimation;
+   float stopBandFreq = outSampleRate - passBandFreq;
+   float cutoff = 0.5 * (passBandFreq + stopBandFreq) / sampleRate; // Normalized
+   float transition = (stopBandFreq - passBandFreq) / sampleRate;   // Normalized
+
+   // Hamming windowed sinc (~53 dB of stop band attenuation, plenty for LEDs). Transition width
+   // of a Hamming window is about 3.3 / numTaps.
+   int numTaps = ceilf(3.3 / transition);
+   numTaps |= 1; // Odd, so the filter is symmetric around the center tap.
+   m_coefs.resize(numTaps);
+
+   float sum = 0;
+   int center = numTaps >> 1;
+   for(int i = 0; i < numTaps; ++i)
+   {
+      int n = i - center;
+      float sinc = n == 0 ? 2.0*cutoff : sin(2.0*M_PI*cutoff*n) / (M_PI*n);
+      float window = 0.54 - 0.46*cos(2.0*M_PI*i/(numTaps-1));
+      m_coefs[i] = sinc * window;
+      sum += m_coefs[i];
+   }
+
+   // Unity gain at DC.
+   for(auto& coef : m_coefs)
+      coef /= sum;
+
+   // Zero pad to a multiple of 8 taps for the vectorized dot product.
+   m_coefs.resize((numTaps + 7) & ~7, 0.0f);
+
+   m_history.assign(m_coefs.size()-1, 0.0f);
+}
+
+void Decimator::flush()
+{
+   std::fill(m_history.begin(), m_history.end(), 0.0f);
+   m_phase = 0;
+}
+
+size_t Decimator::decimate(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp, SpecAnLedTypes::tPcmSample* outSamples)
+{
+   const size_t numTaps = m_coefs.size();
+   const float* coefs = m_coefs.data();
+
+   // Append the new samples after the history.
+   size_t origSize = m_history.size();
+   m_history.resize(origSize + numSamp);
+   for(size_t i = 0; i < numSamp; ++i)
+      m_history[origSize+i] = samples[i];
+
+   // Compute only the output samples that are kept.
+   size_t numOut = 0;
+   size_t index = m_phase;
+   for(; index < numSamp; index += m_decimation)
+   {
+      const float* in = &m_history[index];
+
+      // Two accumulators so the multiply / adds can be pipelined.
+      v4sf accA = {0,0,0,0}, accB = {0,0,0,0};
+      for(size_t tap = 0; tap < numTaps; tap += 8)
+      {
+         v4sf inA, inB, coefA, coefB;
+         memcpy(&inA, &in[tap], sizeof(inA));
+         memcpy(&inB, &in[tap+4], sizeof(inB));
+         memcpy(&coefA, &coefs[tap], sizeof(coefA));
+         memcpy(&coefB, &coefs[tap+4], sizeof(coefB));
+         accA += inA * coefA;
+         accB += inB * coefB;
+      }
+      v4sf acc = accA + accB;
+
+      float outVal = roundf((acc[0] + acc[1]) + (acc[2] + acc[3]));
+      if(outVal > 32767.0f) outVal = 32767.0f;
+      else if(outVal < -32768.0f) outVal = -32768.0f;
+      outSamples[numOut++] = (SpecAnLedTypes::tPcmSample)outVal;
+   }
+   m_phase = index - numSamp;
+
+   // Keep the last (numTaps - 1) samples for next time.
+   memmove(m_history.data(), &m_history[numSamp], origSize*sizeof(m_history[0]));
+   m_history.resize(origSize);
+
+   return numOut;
+}
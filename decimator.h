@@ -0,0 +1,52 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "specAnLedPiTypes.h"
+
+// Low pass filters and decimates PCM samples by an integer factor. Only every Nth output of the
+// FIR filter is computed.
+class Decimator
+{
+public:
+   // 'passBandFreq' is the highest frequency (Hz) that needs to be alias free after decimation.
+   Decimator(float sampleRate, int decimation, float passBandFreq);
+
+   // Returns the number of samples written to 'outSamples' (at most numSamp / decimation + 1).
+   size_t decimate(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp, SpecAnLedTypes::tPcmSample* outSamples);
+
+   int getNumTaps(){return m_coefs.size();}
+
+   // Forget the previous samples (the filter starts over from silence).
+   void flush();
+
+private:
+   // Make uncopyable
+   Decimator();
+   Decimator(Decimator const&);
+   void operator=(Decimator const&);
+
+   int m_decimation;
+   std::vector<float> m_coefs;
+
+   std::vector<float> m_history; // Previous (numTaps - 1) input samples followed by the new samples.
+   int m_phase; // Number of input samples until the next output sample.
+};
@@ -0,0 +1,127 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include "fastMath.h"
+
+typedef float v4sf __attribute__((vector_size(16)));
+typedef int32_t v4si __attribute__((vector_size(16)));
+
+constexpr FastMath::tTable FastMath::LOG2_TABLE = FastMath::makeLog2Table();
+constexpr FastMath::tTable FastMath::EXP2_TABLE = FastMath::makeExp2Table();
+
+// The SIMD forms do the bit manipulation and interpolation 4 values at a time, the table reads
+// are per lane (there is no gather on NEON / SSE2).
+static inline v4sf log2_v4(v4sf x)
+{
+   static constexpr int FRAC_BITS = 23 - FastMath::TABLE_BITS;
+   const v4si one = {0x3F800000, 0x3F800000, 0x3F800000, 0x3F800000}; // 1.0f
+   const v4si expMagic = {0x4B400000, 0x4B400000, 0x4B400000, 0x4B400000}; // 1.5 * 2^23
+
+   v4si bits = (v4si)x;
+   v4si exponent = (bits >> 23) - 127;
+   v4si index = (bits >> FRAC_BITS) & (FastMath::TABLE_SIZE-1);
+
+   // Int to float via the exponent bits (both values are small).
+   v4sf expFlt = (v4sf)(expMagic + exponent) - 12582912.0f;
+   v4sf frac = ((v4sf)((bits & ((1 << FRAC_BITS) - 1)) << FastMath::TABLE_BITS | one) - 1.0f);
+
+   const float* table = FastMath::LOG2_TABLE.values;
+   v4sf t0 = {table[index[0]  ], table[index[1]  ], table[index[2]  ], table[index[3]  ]};
+   v4sf t1 = {table[index[0]+1], table[index[1]+1], table[index[2]+1], table[index[3]+1]};
+   return expFlt + t0 + (t1 - t0) * frac;
+}
+
+static inline v4sf exp2_v4(v4sf x)
+{
+   const v4sf minVal = {-126.0f, -126.0f, -126.0f, -126.0f};
+   const v4sf maxVal = {127.99f, 127.99f, 127.99f, 127.99f};
+   v4si underflow = x < minVal;
+   x = x > maxVal ? maxVal : x;
+   x = x < minVal ? minVal : x;
+
+   // Fixed point with TABLE_BITS fractional bits (rounded towards -infinity), the whole part goes in the exponent.
+   v4sf pos = x * (float)FastMath::TABLE_SIZE;
+   v4sf rounded = (pos + 12582912.0f) - 12582912.0f;
+   rounded -= (v4sf)((v4si)((v4sf){1.0f, 1.0f, 1.0f, 1.0f}) & (rounded > pos));
+   v4si fixed = (v4si)(rounded + 12582912.0f) - 0x4B400000;
+   v4sf frac = pos - rounded;
+   v4si wholeInt = fixed >> FastMath::TABLE_BITS;
+   v4si index = fixed & (FastMath::TABLE_SIZE-1);
+
+   const float* table = FastMath::EXP2_TABLE.values;
+   v4sf t0 = {table[index[0]  ], table[index[1]  ], table[index[2]  ], table[index[3]  ]};
+   v4sf t1 = {table[index[0]+1], table[index[1]+1], table[index[2]+1], table[index[3]+1]};
+   v4sf mantissa = t0 + (t1 - t0) * frac;
+   v4si result = ((v4si)mantissa + (wholeInt << 23)) & ~underflow;
+   return (v4sf)result;
+}
+
+static inline v4sf sqrt_v4(v4sf x)
+{
+   const v4sf zero = {0.0f, 0.0f, 0.0f, 0.0f};
+   v4si positive = x > zero;
+   v4sf invSqrt = (v4sf)(0x5F3759DF - ((v4si)x >> 1));
+   v4sf halfX = 0.5f * x;
+   invSqrt *= 1.5f - halfX * invSqrt * invSqrt;
+   invSqrt *= 1.5f - halfX * invSqrt * invSqrt;
+   return (v4sf)((v4si)(x * invSqrt) & positive);
+}
+
+void FastMath::log(const float* in, float* out, int num)
+{
+   int i = 0;
+   for(; i + 4 <= num; i += 4)
+   {
+      v4sf x;
+      memcpy(&x, &in[i], sizeof(x));
+      x = log2_v4(x) * LN2;
+      memcpy(&out[i], &x, sizeof(x));
+   }
+   for(; i < num; ++i)
+      out[i] = log(in[i]);
+}
+
+void FastMath::pow(const float* in, float power, float* out, int num)
+{
+   const v4sf zero = {0.0f, 0.0f, 0.0f, 0.0f};
+   int i = 0;
+   for(; i + 4 <= num; i += 4)
+   {
+      v4sf x;
+      memcpy(&x, &in[i], sizeof(x));
+      v4si positive = x > zero;
+      x = (v4sf)((v4si)exp2_v4(log2_v4(x) * power) & positive);
+      memcpy(&out[i], &x, sizeof(x));
+   }
+   for(; i < num; ++i)
+      out[i] = pow(in[i], power);
+}
+
+void FastMath::sqrt(const float* in, float* out, int num)
+{
+   int i = 0;
+   for(; i + 4 <= num; i += 4)
+   {
+      v4sf x;
+      memcpy(&x, &in[i], sizeof(x));
+      x = sqrt_v4(x);
+      memcpy(&out[i], &x, sizeof(x));
+   }
+   for(; i < num; ++i)
+      out[i] = sqrt(in[i]);
+}
@@ -0,0 +1,174 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+// Fast approximations of the math functions that are run per LED / per output value every frame.
+// log2 / exp2 are linear interpolations into small tables that are generated at compile time and
+// pow is built on those. The square roots use the inverse square root estimate (the 'Quake'
+// method) with 2 Newton iterations, except scalar sqrt, which is a single instruction on every
+// target (nothing to gain). The batch forms do 4 values at a time.
+//
+// Max errors (measured against double precision on every float in the range). The log errors are
+// absolute and grow with |log2(x)|, since the result is rounded to a float:
+//    log2(x):   2.8e-6 for 0.5 <= x <= 2, 4.4e-6 for 1e-6 <= x <= 1e6, 9.7e-6 for 1e-20 <= x <= 1e20
+//               and for all the normal floats (0 gives -127, i.e. a very small number)
+//    log(x):    2.0e-6 for 0.5 <= x <= 2, 3.5e-6 for 1e-6 <= x <= 1e6, 8.7e-6 for 1e-20 <= x <= 1e20,
+//               1.1e-5 for all the normal floats
+//    exp2(x):   1.1e-6 relative   -126 <= x < 127.99 (clamped outside that)
+//    pow(x, p): 4.3e-6 relative   1e-3 <= x <= 1, p = 1.8 (grows with |p * log2(x)|, 1.5e-5 for 1e-20 <= x <= 1)
+//    sqrt(x):   4.8e-6 relative   all the normal floats (batch form, the scalar form is exact)
+//    invSqrt(x): 4.8e-6 relative  all the normal floats
+namespace FastMath
+{
+   static constexpr int TABLE_BITS = 8;
+   static constexpr int TABLE_SIZE = 1 << TABLE_BITS;
+   static constexpr float LN2 = 0.693147180559945f;
+
+   // One extra entry so index+1 is always valid.
+   typedef struct
+   {
+      float values[TABLE_SIZE+1];
+   }tTable;
+
+   extern const tTable LOG2_TABLE; // log2(1 + i/TABLE_SIZE)
+   extern const tTable EXP2_TABLE; // 2^(i/TABLE_SIZE)
+
+   static inline uint32_t floatBits(float val)
+   {
+      uint32_t bits;
+      memcpy(&bits, &val, sizeof(bits));
+      return bits;
+   }
+
+   static inline float bitsFloat(uint32_t bits)
+   {
+      float val;
+      memcpy(&val, &bits, sizeof(val));
+      return val;
+   }
+
+   static inline float log2(float x)
+   {
+      static constexpr int FRAC_BITS = 23 - TABLE_BITS;
+      uint32_t bits = floatBits(x);
+      int exponent = (int)(bits >> 23) - 127;
+      uint32_t index = (bits >> FRAC_BITS) & (TABLE_SIZE-1);
+      float frac = (float)(bits & ((1 << FRAC_BITS) - 1)) * (1.0f / (float)(1 << FRAC_BITS));
+      const float* table = &LOG2_TABLE.values[index];
+      return (float)exponent + table[0] + (table[1] - table[0]) * frac;
+   }
+
+   static inline float log(float x)
+   {
+      return log2(x) * LN2;
+   }
+
+   static inline float exp2(float x)
+   {
+      if(x < -126.0f)
+         return 0.0f;
+      if(x > 127.99f)
+         x = 127.99f;
+      // Fixed point with TABLE_BITS fractional bits, the whole part goes in the exponent.
+      float pos = x * (float)TABLE_SIZE;
+      int fixed = (int)pos;
+      if(pos < (float)fixed)
+         fixed--; // Round towards -infinity.
+      float frac = pos - (float)fixed;
+      int whole = fixed >> TABLE_BITS;
+      const float* table = &EXP2_TABLE.values[fixed & (TABLE_SIZE-1)];
+      float mantissa = table[0] + (table[1] - table[0]) * frac; // 1 to 2
+      return bitsFloat(floatBits(mantissa) + ((uint32_t)whole << 23));
+   }
+
+   static inline float pow(float x, float power)
+   {
+      return x > 0.0f ? exp2(power * log2(x)) : 0.0f;
+   }
+
+   static inline float sqrt(float x)
+   {
+      return x > 0.0f ? sqrtf(x) : 0.0f;
+   }
+
+   // 1 / sqrt(x), without the square root or the divide.
+   static inline float invSqrt(float x)
+   {
+      float estimate = bitsFloat(0x5F3759DF - (floatBits(x) >> 1));
+      float halfX = 0.5f * x;
+      estimate *= 1.5f - halfX * estimate * estimate;
+      estimate *= 1.5f - halfX * estimate * estimate;
+      return estimate;
+   }
+
+   // Batch forms, 'in' and 'out' can be the same buffer.
+   void log(const float* in, float* out, int num);
+   void pow(const float* in, float power, float* out, int num);
+   void sqrt(const float* in, float* out, int num);
+
+   ////////////////////////////////////////////////////////////////////////////
+   // Compile time helpers
+   ////////////////////////////////////////////////////////////////////////////
+   // ln(x) = 2*atanh((x-1)/(x+1)), converges quickly for x between 1 and 2.
+   constexpr double constexprLog(double x)
+   {
+      double z = (x - 1.0) / (x + 1.0);
+      double z2 = z*z;
+      double term = z;
+      double sum = 0.0;
+      for(int n = 0; n < 20; ++n)
+      {
+         sum += term / (2*n+1);
+         term *= z2;
+      }
+      return 2.0 * sum;
+   }
+
+   constexpr double constexprExp(double x)
+   {
+      double term = 1.0;
+      double sum = 1.0;
+      for(int n = 1; n < 24; ++n)
+      {
+         term *= x / n;
+         sum += term;
+      }
+      return sum;
+   }
+
+   constexpr tTable makeLog2Table()
+   {
+      tTable table = {};
+      for(int i = 0; i <= TABLE_SIZE; ++i)
+         table.values[i] = constexprLog(1.0 + (double)i / TABLE_SIZE) / constexprLog(2.0);
+      return table;
+   }
+
+   constexpr tTable makeExp2Table()
+   {
+      tTable table = {};
+      for(int i = 0; i <= TABLE_SIZE; ++i)
+         table.values[i] = constexprExp((double)i / TABLE_SIZE * constexprLog(2.0));
+      return table;
+   }
+}
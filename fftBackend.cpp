@@ -0,0 +1,182 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include "fftBackend.h"
+#include "fftBackendFloat.h"
+#include "fftBackendFixed.h"
+#include "fftKernels.h"
+#include "cpuFeatures.h"
+
+#ifndef NO_NE10
+#include "NE10.h"
+
+// NE10 int16 NEON FFT. Only usable on CPUs with NEON (i.e. not ARMv6 Pi Zeros).
+class FftBackendNe10 : public FftBackend
+{
+public:
+   FftBackendNe10(int numTaps):
+      FftBackend(numTaps)
+   {
+      m_ne10Config = ne10_fft_alloc_r2c_int16(numTaps);
+   }
+
+   virtual ~FftBackendNe10()
+   {
+      ne10_fft_destroy_r2c_int16(m_ne10Config);
+   }
+
+   void runFft(const int16_t* inSamp, tComplex* outBins) override
+   {
+      // NE10 doesn't modify the input, it just isn't const correct.
+      ne10_fft_r2c_1d_int16_neon((ne10_fft_cpx_int16_t*)outBins, (ne10_int16_t*)inSamp, m_ne10Config, 1);
+   }
+
+   const char* getName() override
+   {
+      return "NE10 NEON";
+   }
+
+private:
+   ne10_fft_r2c_cfg_int16_t m_ne10Config;
+};
+#endif
+
+
+FftBackend::FftBackend(int numTaps):
+   m_numTaps(numTaps),
+   m_bins((numTaps>>1)+1)
+{
+
+}
+
+FftBackend::~FftBackend()
+{
+
+}
+
+void FftBackend::setWindow(const std::vector<int16_t>& windowQ15)
+{
+   m_windowCoefs = windowQ15;
+   m_windowedInput.resize(m_windowCoefs.size());
+}
+
+const int16_t* FftBackend::window(const int16_t* inSamp)
+{
+   if(m_windowCoefs.size() > 0)
+   {
+      FftKernels::applyWindow(inSamp, m_windowCoefs.data(), m_windowedInput.data(), m_numTaps);
+      return m_windowedInput.data();
+   }
+   return inSamp;
+}
+
+void FftBackend::runFftMag(const int16_t* inSamp, uint16_t* outMag)
+{
+   runFft(window(inSamp), m_bins.data());
+   FftKernels::magnitude(m_bins.data(), outMag, m_numTaps>>1);
+}
+
+void FftBackend::runFftPower(const int16_t* inSamp, float* outPower)
+{
+   runFft(window(inSamp), m_bins.data());
+   FftKernels::power(m_bins.data(), outPower, m_numTaps>>1);
+}
+
+std::unique_ptr<FftBackend> FftBackend::create(int numTaps, eBackendType type)
+{
+   if(type == E_BACKEND_FASTEST)
+   {
+      type = E_BACKEND_FLOAT_SCALAR;
+      if(CpuFeatures::hasAvx())
+         type = E_BACKEND_FLOAT_AVX;
+      else if(CpuFeatures::hasSse2())
+         type = E_BACKEND_FLOAT_SSE;
+#ifndef NO_NE10
+      if(CpuFeatures::hasNeon())
+         type = E_BACKEND_NE10;
+#endif
+   }
+
+   FftBackend* backend = nullptr;
+   switch(type)
+   {
+#ifndef NO_NE10
+      case E_BACKEND_NE10:
+         if(CpuFeatures::hasNeon())
+            backend = new FftBackendNe10(numTaps);
+      break;
+#endif
+      case E_BACKEND_FLOAT_SCALAR:
+         backend = new FftBackendFloat(numTaps, FftBackendFloat::E_KERNEL_SCALAR);
+      break;
+      case E_BACKEND_FLOAT_SSE:
+         if(CpuFeatures::hasSse2())
+            backend = new FftBackendFloat(numTaps, FftBackendFloat::E_KERNEL_SSE);
+      break;
+      case E_BACKEND_FLOAT_AVX:
+         if(CpuFeatures::hasAvx())
+            backend = new FftBackendFloat(numTaps, FftBackendFloat::E_KERNEL_AVX);
+      break;
+      case E_BACKEND_INT16_SCALAR:
+         backend = new FftBackendFixed(numTaps, FftBackendFixed::E_FIXED_INT16);
+      break;
+      case E_BACKEND_INT32_BFP:
+         backend = new FftBackendFixed(numTaps, FftBackendFixed::E_FIXED_INT32_BFP);
+      break;
+      default:
+      break;
+   }
+   return std::unique_ptr<FftBackend>(backend);
+}
+
+FftBackend::eBackendType FftBackend::getBackendType(ePrecision precision)
+{
+   switch(precision)
+   {
+      case E_PRECISION_INT16:
+#ifndef NO_NE10
+         if(CpuFeatures::hasNeon())
+            return E_BACKEND_NE10;
+#endif
+         return E_BACKEND_INT16_SCALAR;
+      case E_PRECISION_INT32_BFP:
+         return E_BACKEND_INT32_BFP;
+      case E_PRECISION_FLOAT:
+         if(CpuFeatures::hasAvx())
+            return E_BACKEND_FLOAT_AVX;
+         else if(CpuFeatures::hasSse2())
+            return E_BACKEND_FLOAT_SSE;
+         return E_BACKEND_FLOAT_SCALAR;
+      default:
+      break;
+   }
+   return E_BACKEND_FASTEST;
+}
+
+const char* FftBackend::getPrecisionName(ePrecision precision)
+{
+   switch(precision)
+   {
+      case E_PRECISION_INT16:     return "Int16";
+      case E_PRECISION_INT32_BFP: return "Int32 BFP";
+      case E_PRECISION_FLOAT:     return "Float";
+      default:
+      break;
+   }
+   return "Fastest";
+}
@@ -0,0 +1,101 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+// Interface to the code that actually runs the FFT. SpecAnFft picks the fastest
+// implementation the running CPU supports via FftBackend::create.
+class FftBackend
+{
+public:
+   typedef struct
+   {
+      int16_t r;
+      int16_t i;
+   }tComplex; // Same memory layout as ne10_fft_cpx_int16_t
+
+   typedef enum
+   {
+      E_BACKEND_FASTEST, // Fastest one the running CPU supports.
+      E_BACKEND_NE10,
+      E_BACKEND_FLOAT_SCALAR,
+      E_BACKEND_FLOAT_SSE,
+      E_BACKEND_FLOAT_AVX,
+      E_BACKEND_INT16_SCALAR, // Same precision as NE10, for CPUs without NEON.
+      E_BACKEND_INT32_BFP
+   }eBackendType;
+
+   typedef enum
+   {
+      E_PRECISION_FASTEST, // Whatever precision the fastest backend has.
+      E_PRECISION_INT16,
+      E_PRECISION_INT32_BFP, // 32 bit block floating point.
+      E_PRECISION_FLOAT,
+      E_NUM_PRECISIONS
+   }ePrecision;
+
+   FftBackend(int numTaps);
+   virtual ~FftBackend();
+
+   // Real to complex FFT of 'numTaps' samples. 'outBins' must have room for (numTaps/2)+1 bins.
+   // The output is scaled by 1/numTaps (i.e. matches the scaled NE10 int16 FFT).
+   // Note: the window is NOT applied.
+   virtual void runFft(const int16_t* inSamp, tComplex* outBins) = 0;
+
+   // Window + FFT + Magnitude in one call. 'outMag' gets numTaps/2 magnitudes (DC up to, but not including, Nyquist).
+   // Backends that can fold the window / magnitude into the FFT itself should override this.
+   virtual void runFftMag(const int16_t* inSamp, uint16_t* outMag);
+
+   // Same as runFftMag, but outputs the squared magnitude (i.e. power) so no square roots are needed.
+   // The units match runFftMag (i.e. sqrt(outPower[i]) is the magnitude).
+   virtual void runFftPower(const int16_t* inSamp, float* outPower);
+
+   // Q15 window coefficients to apply in runFftMag. Empty means no window.
+   virtual void setWindow(const std::vector<int16_t>& windowQ15);
+
+   virtual const char* getName() = 0;
+
+   // Returns nullptr if the requested backend isn't available on the running CPU.
+   static std::unique_ptr<FftBackend> create(int numTaps, eBackendType type = E_BACKEND_FASTEST);
+
+   // Fastest backend with the requested precision on the running CPU.
+   static eBackendType getBackendType(ePrecision precision);
+   static const char* getPrecisionName(ePrecision precision);
+
+protected:
+   const int m_numTaps;
+   std::vector<int16_t> m_windowCoefs;
+
+   // Buffers for the default runFftMag / runFftPower.
+   std::vector<int16_t> m_windowedInput;
+   std::vector<tComplex> m_bins;
+
+   // Returns either the windowed input or the input (if there is no window).
+   const int16_t* window(const int16_t* inSamp);
+
+private:
+   // Make uncopyable
+   FftBackend();
+   FftBackend(FftBackend const&);
+   void operator=(FftBackend const&);
+};
+
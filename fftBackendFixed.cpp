@@ -0,0 +1,343 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <assert.h>
+#include <math.h>
+#include "fftBackendFixed.h"
+
+// Largest block value (as a bit mask) that can go through a radix 2 butterfly without overflowing
+// 32 bits. The real / imaginary parts can grow by up to 1 + sqrt(2) per stage.
+#define BFP_NO_SHIFT_LIMIT (1u << 29)
+#define BFP_ONE_SHIFT_LIMIT (1u << 30)
+
+static inline int32_t toQ(double val, int bits)
+{
+   double scaled = round(val * (double)(1ll << bits));
+   double maxVal = (double)((1ll << bits) - 1); // 1.0 isn't representable, use the closest value.
+   if(scaled > maxVal)
+      scaled = maxVal;
+   return (int32_t)scaled;
+}
+
+static inline int16_t saturateInt16(int64_t val)
+{
+   if(val > 32767)
+      return 32767;
+   else if(val < -32768)
+      return -32768;
+   return (int16_t)val;
+}
+
+static inline uint32_t absVal(int32_t val)
+{
+   return val < 0 ? (uint32_t)(-(int64_t)val) : (uint32_t)val;
+}
+
+static inline int highestBit(uint32_t val)
+{
+   int bit = -1;
+   while(val != 0)
+   {
+      val >>= 1;
+      bit++;
+   }
+   return bit;
+}
+
+FftBackendFixed::FftBackendFixed(int numTaps, eFixedType type):
+   FftBackend(numTaps),
+   m_numCpx(numTaps>>1),
+   m_type(type),
+   m_twiddleBits(type == E_FIXED_INT16 ? 15 : 31),
+   m_splitBits(type == E_FIXED_INT16 ? 15 : 30), // Q30 so the split step sums fit in 64 bits.
+   m_blockBits(0),
+   m_exponent(0)
+{
+   assert(numTaps >= 8 && (numTaps & (numTaps-1)) == 0); // Must be a power of 2.
+
+   // Bit reverse table.
+   int numBits = 0;
+   while((1 << numBits) < m_numCpx)
+      numBits++;
+   m_bitRev.resize(m_numCpx);
+   for(int i = 0; i < m_numCpx; ++i)
+   {
+      int rev = 0;
+      for(int bit = 0; bit < numBits; ++bit)
+      {
+         if(i & (1 << bit))
+            rev |= 1 << (numBits - 1 - bit);
+      }
+      m_bitRev[i] = rev;
+   }
+
+   // Per stage twiddles.
+   m_twiddleRe.resize(m_numCpx);
+   m_twiddleIm.resize(m_numCpx);
+   for(int half = 1; half < m_numCpx; half <<= 1)
+   {
+      for(int j = 0; j < half; ++j)
+      {
+         double angle = M_PI * (double)j / (double)half;
+         m_twiddleRe[half-1+j] = toQ( cos(angle), m_twiddleBits);
+         m_twiddleIm[half-1+j] = toQ(-sin(angle), m_twiddleBits);
+      }
+   }
+
+   // Real FFT split twiddles.
+   m_splitRe.resize(m_numCpx);
+   m_splitIm.resize(m_numCpx);
+   for(int k = 0; k < m_numCpx; ++k)
+   {
+      double angle = 2.0 * M_PI * (double)k / (double)numTaps;
+      m_splitRe[k] = toQ( cos(angle), m_splitBits);
+      m_splitIm[k] = toQ(-sin(angle), m_splitBits);
+   }
+
+   m_re.resize(m_numCpx);
+   m_im.resize(m_numCpx);
+   m_power.resize(m_numCpx);
+}
+
+FftBackendFixed::~FftBackendFixed()
+{
+
+}
+
+const char* FftBackendFixed::getName()
+{
+   return m_type == E_FIXED_INT16 ? "Int16 Scalar" : "Int32 BFP Scalar";
+}
+
+void FftBackendFixed::runFft(const int16_t* inSamp, tComplex* outBins)
+{
+   load(inSamp, nullptr);
+   runStages();
+   splitRealFft(outBins);
+}
+
+void FftBackendFixed::runFftMag(const int16_t* inSamp, uint16_t* outMag)
+{
+   if(m_type == E_FIXED_INT16)
+   {
+      FftBackend::runFftMag(inSamp, outMag); // Window the int16 samples, just like NE10.
+      return;
+   }
+
+   load(inSamp, m_windowCoefs.size() > 0 ? m_windowCoefs.data() : nullptr);
+   runStages();
+   splitRealFftPower(m_power.data());
+   for(int k = 0; k < m_numCpx; ++k)
+   {
+      float mag = sqrtf(m_power[k]) + 0.5f;
+      outMag[k] = mag > 65535.0f ? 65535 : (uint16_t)mag;
+   }
+}
+
+void FftBackendFixed::runFftPower(const int16_t* inSamp, float* outPower)
+{
+   if(m_type == E_FIXED_INT16)
+   {
+      FftBackend::runFftPower(inSamp, outPower); // Window the int16 samples, just like NE10.
+      return;
+   }
+
+   load(inSamp, m_windowCoefs.size() > 0 ? m_windowCoefs.data() : nullptr);
+   runStages();
+   splitRealFftPower(outPower);
+}
+
+void FftBackendFixed::load(const int16_t* inSamp, const int16_t* windowQ15)
+{
+   // Even samples go in the real part, odd samples go in the imaginary part.
+   uint32_t blockBits = 0;
+   if(m_type == E_FIXED_INT16)
+   {
+      for(int i = 0; i < m_numCpx; ++i)
+      {
+         const int16_t* samp = &inSamp[m_bitRev[i]<<1];
+         m_re[i] = samp[0];
+         m_im[i] = samp[1];
+      }
+      m_exponent = 0;
+   }
+   else if(windowQ15 != nullptr)
+   {
+      // Keep the full Q15 product (no >> 15).
+      for(int i = 0; i < m_numCpx; ++i)
+      {
+         int sampIndex = m_bitRev[i]<<1;
+         m_re[i] = (int32_t)inSamp[sampIndex  ] * (int32_t)windowQ15[sampIndex  ];
+         m_im[i] = (int32_t)inSamp[sampIndex+1] * (int32_t)windowQ15[sampIndex+1];
+         blockBits |= absVal(m_re[i]) | absVal(m_im[i]);
+      }
+      m_exponent = -15;
+   }
+   else
+   {
+      for(int i = 0; i < m_numCpx; ++i)
+      {
+         const int16_t* samp = &inSamp[m_bitRev[i]<<1];
+         m_re[i] = samp[0];
+         m_im[i] = samp[1];
+         blockBits |= absVal(m_re[i]) | absVal(m_im[i]);
+      }
+      m_exponent = 0;
+   }
+   m_blockBits = blockBits;
+
+   if(m_type == E_FIXED_INT32_BFP)
+      normalize();
+}
+
+void FftBackendFixed::normalize()
+{
+   // Scale the block so the largest value is just under BFP_NO_SHIFT_LIMIT. Quiet signals get
+   // shifted up, which is where the extra dynamic range comes from.
+   if(m_blockBits == 0)
+      return;
+   int shift = highestBit(BFP_NO_SHIFT_LIMIT) - 1 - highestBit(m_blockBits);
+   if(shift > 0)
+   {
+      for(int i = 0; i < m_numCpx; ++i)
+      {
+         m_re[i] <<= shift;
+         m_im[i] <<= shift;
+      }
+   }
+   else if(shift < 0)
+   {
+      for(int i = 0; i < m_numCpx; ++i)
+      {
+         m_re[i] >>= -shift;
+         m_im[i] >>= -shift;
+      }
+   }
+   m_blockBits = shift >= 0 ? (m_blockBits << shift) : (m_blockBits >> -shift);
+   m_exponent -= shift;
+}
+
+void FftBackendFixed::runStages()
+{
+   const int twiddleBits = m_twiddleBits;
+   const int64_t round = 1ll << (twiddleBits-1);
+   int32_t* re = m_re.data();
+   int32_t* im = m_im.data();
+
+   for(int half = 1; half < m_numCpx; half <<= 1)
+   {
+      // Int16 always scales by 1/2 (like NE10). Block floating point only scales when it has to.
+      int shift = 1;
+      if(m_type == E_FIXED_INT32_BFP)
+         shift = m_blockBits < BFP_NO_SHIFT_LIMIT ? 0 : (m_blockBits < BFP_ONE_SHIFT_LIMIT ? 1 : 2);
+      m_exponent += shift;
+
+      const int32_t* twRe = &m_twiddleRe[half-1];
+      const int32_t* twIm = &m_twiddleIm[half-1];
+      uint32_t blockBits = 0;
+      for(int base = 0; base < m_numCpx; base += (half<<1))
+      {
+         int32_t* aRe = re + base;
+         int32_t* aIm = im + base;
+         int32_t* bRe = aRe + half;
+         int32_t* bIm = aIm + half;
+         for(int j = 0; j < half; ++j)
+         {
+            int64_t tRe = ((int64_t)bRe[j]*twRe[j] - (int64_t)bIm[j]*twIm[j] + round) >> twiddleBits;
+            int64_t tIm = ((int64_t)bRe[j]*twIm[j] + (int64_t)bIm[j]*twRe[j] + round) >> twiddleBits;
+            int64_t xRe = aRe[j];
+            int64_t xIm = aIm[j];
+            aRe[j] = (int32_t)((xRe + tRe) >> shift);
+            aIm[j] = (int32_t)((xIm + tIm) >> shift);
+            bRe[j] = (int32_t)((xRe - tRe) >> shift);
+            bIm[j] = (int32_t)((xIm - tIm) >> shift);
+            blockBits |= absVal(aRe[j]) | absVal(aIm[j]) | absVal(bRe[j]) | absVal(bIm[j]);
+         }
+      }
+      m_blockBits = blockBits;
+   }
+}
+
+inline void FftBackendFixed::splitStep(int k, int64_t& xr, int64_t& xi)
+{
+   // Same as FftBackendFloat::splitStep (output is scaled by 2).
+   int n = m_numCpx - k;
+   int64_t er = (int64_t)m_re[k] + m_re[n];
+   int64_t ei = (int64_t)m_im[k] - m_im[n];
+   int64_t dr = (int64_t)m_re[k] - m_re[n];
+   int64_t di = (int64_t)m_im[k] + m_im[n];
+
+   int64_t wr = m_splitRe[k];
+   int64_t wi = m_splitIm[k];
+   int64_t round = 1ll << (m_splitBits-1);
+   xr = er + ((wr*di + wi*dr + round) >> m_splitBits);
+   xi = ei + ((wi*di - wr*dr + round) >> m_splitBits);
+}
+
+void FftBackendFixed::splitRealFft(tComplex* outBins)
+{
+   if(m_type == E_FIXED_INT16)
+   {
+      // The stages already scaled by 1/numCpx, the split step output is scaled by 2 and still
+      // needs the last 1/2.
+      outBins[0].r = saturateInt16(((int64_t)m_re[0] + m_im[0]) >> 1);
+      outBins[0].i = 0;
+      outBins[m_numCpx].r = saturateInt16(((int64_t)m_re[0] - m_im[0]) >> 1);
+      outBins[m_numCpx].i = 0;
+      for(int k = 1; k < m_numCpx; ++k)
+      {
+         int64_t xr, xi;
+         splitStep(k, xr, xi);
+         outBins[k].r = saturateInt16(xr >> 2);
+         outBins[k].i = saturateInt16(xi >> 2);
+      }
+      return;
+   }
+
+   const float scale = ldexpf(1.0f, m_exponent) / (float)m_numTaps;
+   const float halfScale = 0.5f * scale;
+   outBins[0].r = saturateInt16(lrintf((float)((int64_t)m_re[0] + m_im[0]) * scale));
+   outBins[0].i = 0;
+   outBins[m_numCpx].r = saturateInt16(lrintf((float)((int64_t)m_re[0] - m_im[0]) * scale));
+   outBins[m_numCpx].i = 0;
+   for(int k = 1; k < m_numCpx; ++k)
+   {
+      int64_t xr, xi;
+      splitStep(k, xr, xi);
+      outBins[k].r = saturateInt16(lrintf((float)xr * halfScale));
+      outBins[k].i = saturateInt16(lrintf((float)xi * halfScale));
+   }
+}
+
+void FftBackendFixed::splitRealFftPower(float* outPower)
+{
+   // Only the block exponent goes through floating point, the bins themselves are integers.
+   const float scale = ldexpf(1.0f, m_exponent) / (float)m_numTaps;
+   const float halfScale = 0.5f * scale;
+
+   float dc = (float)((int64_t)m_re[0] + m_im[0]) * scale;
+   outPower[0] = dc * dc;
+   for(int k = 1; k < m_numCpx; ++k)
+   {
+      int64_t xr, xi;
+      splitStep(k, xr, xi);
+      float fr = (float)xr * halfScale;
+      float fi = (float)xi * halfScale;
+      outPower[k] = fr*fr + fi*fi;
+   }
+}
@@ -0,0 +1,84 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <vector>
+#include "fftBackend.h"
+
+// Portable fixed point real FFT. Same structure as FftBackendFloat (a complex FFT of half the size
+// followed by a split step), but all the butterflies are done with integer math.
+//
+// E_FIXED_INT16: Every stage is scaled by 1/2 and the window is applied to the int16 samples
+//    (i.e. the same precision as the NE10 int16 FFT, for CPUs without NEON).
+// E_FIXED_INT32_BFP: Block floating point. The window is applied without dropping any bits, the
+//    block is normalized to use the full 32 bit range and stages are only scaled down when they
+//    could overflow. The shifts are tracked in a block exponent that is removed at the output.
+class FftBackendFixed : public FftBackend
+{
+public:
+   typedef enum
+   {
+      E_FIXED_INT16,
+      E_FIXED_INT32_BFP
+   }eFixedType;
+
+   FftBackendFixed(int numTaps, eFixedType type);
+   virtual ~FftBackendFixed();
+
+   void runFft(const int16_t* inSamp, tComplex* outBins) override;
+   void runFftMag(const int16_t* inSamp, uint16_t* outMag) override;
+   void runFftPower(const int16_t* inSamp, float* outPower) override;
+
+   const char* getName() override;
+
+private:
+   // Make uncopyable
+   FftBackendFixed();
+   FftBackendFixed(FftBackendFixed const&);
+   void operator=(FftBackendFixed const&);
+
+   int m_numCpx; // Size of the complex FFT (i.e. half the number of real taps).
+   eFixedType m_type;
+   int m_twiddleBits; // Q format of the butterfly twiddles.
+   int m_splitBits;   // Q format of the split step twiddles.
+
+   std::vector<int> m_bitRev;
+
+   // Twiddles for every stage, back to back. The stage with 'half' butterflies per group starts at index 'half-1'.
+   std::vector<int32_t> m_twiddleRe;
+   std::vector<int32_t> m_twiddleIm;
+
+   // Twiddles for separating the real FFT from the complex FFT.
+   std::vector<int32_t> m_splitRe;
+   std::vector<int32_t> m_splitIm;
+
+   // Working buffers.
+   std::vector<int32_t> m_re;
+   std::vector<int32_t> m_im;
+   std::vector<float> m_power; // For runFftMag.
+   uint32_t m_blockBits; // OR of the absolute values in the working buffers (for overflow checks).
+   int m_exponent;       // Working buffer value * 2^m_exponent = unscaled complex FFT value.
+
+   void load(const int16_t* inSamp, const int16_t* windowQ15);
+   void normalize();
+   void runStages();
+   inline void splitStep(int k, int64_t& xr, int64_t& xi);
+   void splitRealFft(tComplex* outBins);
+   void splitRealFftPower(float* outPower);
+};
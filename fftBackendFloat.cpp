@@ -0,0 +1,485 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <assert.h>
+#include <math.h>
+#include "fftBackendFloat.h"
+#include "cpuFeatures.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FFT_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+static inline uint16_t floatToUint16(float val)
+{
+   val += 0.5f; // Round to nearest (only positive values come in here).
+   if(val > 65535.0f)
+      return 65535;
+   return (uint16_t)val;
+}
+
+static inline int16_t floatToInt16(float val)
+{
+   val += (val >= 0.0f ? 0.5f : -0.5f); // Round to nearest.
+   if(val > 32767.0f)
+      return 32767;
+   else if(val < -32768.0f)
+      return -32768;
+   return (int16_t)val;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Butterfly Kernels. Each one runs a full radix 2 stage (all the groups).
+////////////////////////////////////////////////////////////////////////////////
+static void stage_scalar(float* re, float* im, const float* twRe, const float* twIm, int numCpx, int half)
+{
+   for(int base = 0; base < numCpx; base += (half<<1))
+   {
+      float* aRe = re + base;
+      float* aIm = im + base;
+      float* bRe = aRe + half;
+      float* bIm = aIm + half;
+      for(int j = 0; j < half; ++j)
+      {
+         float tRe = bRe[j]*twRe[j] - bIm[j]*twIm[j];
+         float tIm = bRe[j]*twIm[j] + bIm[j]*twRe[j];
+         bRe[j] = aRe[j] - tRe;
+         bIm[j] = aIm[j] - tIm;
+         aRe[j] += tRe;
+         aIm[j] += tIm;
+      }
+   }
+}
+
+#ifdef FFT_X86_KERNELS
+__attribute__((target("sse2")))
+static void stage_sse(float* re, float* im, const float* twRe, const float* twIm, int numCpx, int half)
+{
+   for(int base = 0; base < numCpx; base += (half<<1))
+   {
+      float* aRe = re + base;
+      float* aIm = im + base;
+      float* bRe = aRe + half;
+      float* bIm = aIm + half;
+      for(int j = 0; j < half; j += 4)
+      {
+         __m128 wr = _mm_loadu_ps(twRe+j);
+         __m128 wi = _mm_loadu_ps(twIm+j);
+         __m128 br = _mm_loadu_ps(bRe+j);
+         __m128 bi = _mm_loadu_ps(bIm+j);
+         __m128 ar = _mm_loadu_ps(aRe+j);
+         __m128 ai = _mm_loadu_ps(aIm+j);
+         __m128 tr = _mm_sub_ps(_mm_mul_ps(br, wr), _mm_mul_ps(bi, wi));
+         __m128 ti = _mm_add_ps(_mm_mul_ps(br, wi), _mm_mul_ps(bi, wr));
+         _mm_storeu_ps(bRe+j, _mm_sub_ps(ar, tr));
+         _mm_storeu_ps(bIm+j, _mm_sub_ps(ai, ti));
+         _mm_storeu_ps(aRe+j, _mm_add_ps(ar, tr));
+         _mm_storeu_ps(aIm+j, _mm_add_ps(ai, ti));
+      }
+   }
+}
+
+// Real FFT split step for bins k to k+3 (output is scaled by 2).
+__attribute__((target("sse2")))
+static inline void splitStep_sse(const float* re, const float* im, const float* splitRe, const float* splitIm, int numCpx, int k, __m128& xr, __m128& xi)
+{
+   int n = numCpx - k - 3; // Mirrored bins (need to be reversed).
+   __m128 rk = _mm_loadu_ps(re+k);
+   __m128 ik = _mm_loadu_ps(im+k);
+   __m128 rn = _mm_loadu_ps(re+n);
+   __m128 in = _mm_loadu_ps(im+n);
+   rn = _mm_shuffle_ps(rn, rn, _MM_SHUFFLE(0,1,2,3));
+   in = _mm_shuffle_ps(in, in, _MM_SHUFFLE(0,1,2,3));
+
+   __m128 er = _mm_add_ps(rk, rn);
+   __m128 ei = _mm_sub_ps(ik, in);
+   __m128 dr = _mm_sub_ps(rk, rn);
+   __m128 di = _mm_add_ps(ik, in);
+
+   __m128 wr = _mm_loadu_ps(splitRe+k);
+   __m128 wi = _mm_loadu_ps(splitIm+k);
+   xr = _mm_add_ps(er, _mm_add_ps(_mm_mul_ps(wr, di), _mm_mul_ps(wi, dr)));
+   xi = _mm_add_ps(_mm_sub_ps(ei, _mm_mul_ps(wr, dr)), _mm_mul_ps(wi, di));
+}
+
+// Real FFT split step and magnitude, 4 bins at a time. Starts at bin 1 and returns
+// where it stopped (the remaining bins need to be done by the caller).
+__attribute__((target("sse2")))
+static int splitMag_sse(const float* re, const float* im, const float* splitRe, const float* splitIm, int numCpx, float halfScale, uint16_t* outMag)
+{
+   const __m128 scale = _mm_set1_ps(halfScale);
+   const __m128 half = _mm_set1_ps(0.5f);
+   const __m128 maxU16 = _mm_set1_ps(65535.0f);
+   const __m128i bias32 = _mm_set1_epi32(0x8000);
+   const __m128i bias16 = _mm_set1_epi16((int16_t)0x8000);
+
+   int k = 1;
+   for(; k + 4 <= numCpx; k += 4)
+   {
+      __m128 xr, xi;
+      splitStep_sse(re, im, splitRe, splitIm, numCpx, k, xr, xi);
+
+      __m128 mag = _mm_mul_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(xr, xr), _mm_mul_ps(xi, xi))), scale);
+      mag = _mm_min_ps(_mm_add_ps(mag, half), maxU16);
+
+      // No unsigned saturating pack in SSE2, so shift to signed, pack, then shift back.
+      __m128i magInt = _mm_sub_epi32(_mm_cvttps_epi32(mag), bias32);
+      _mm_storel_epi64((__m128i*)&outMag[k], _mm_add_epi16(_mm_packs_epi32(magInt, magInt), bias16));
+   }
+   return k;
+}
+
+// Same as splitMag_sse, but outputs the squared magnitude (i.e. no square root).
+__attribute__((target("sse2")))
+static int splitPower_sse(const float* re, const float* im, const float* splitRe, const float* splitIm, int numCpx, float halfScale, float* outPower)
+{
+   const __m128 scale = _mm_set1_ps(halfScale*halfScale);
+
+   int k = 1;
+   for(; k + 4 <= numCpx; k += 4)
+   {
+      __m128 xr, xi;
+      splitStep_sse(re, im, splitRe, splitIm, numCpx, k, xr, xi);
+      _mm_storeu_ps(&outPower[k], _mm_mul_ps(_mm_add_ps(_mm_mul_ps(xr, xr), _mm_mul_ps(xi, xi)), scale));
+   }
+   return k;
+}
+
+__attribute__((target("avx")))
+static void stage_avx(float* re, float* im, const float* twRe, const float* twIm, int numCpx, int half)
+{
+   for(int base = 0; base < numCpx; base += (half<<1))
+   {
+      float* aRe = re + base;
+      float* aIm = im + base;
+      float* bRe = aRe + half;
+      float* bIm = aIm + half;
+      for(int j = 0; j < half; j += 8)
+      {
+         __m256 wr = _mm256_loadu_ps(twRe+j);
+         __m256 wi = _mm256_loadu_ps(twIm+j);
+         __m256 br = _mm256_loadu_ps(bRe+j);
+         __m256 bi = _mm256_loadu_ps(bIm+j);
+         __m256 ar = _mm256_loadu_ps(aRe+j);
+         __m256 ai = _mm256_loadu_ps(aIm+j);
+         __m256 tr = _mm256_sub_ps(_mm256_mul_ps(br, wr), _mm256_mul_ps(bi, wi));
+         __m256 ti = _mm256_add_ps(_mm256_mul_ps(br, wi), _mm256_mul_ps(bi, wr));
+         _mm256_storeu_ps(bRe+j, _mm256_sub_ps(ar, tr));
+         _mm256_storeu_ps(bIm+j, _mm256_sub_ps(ai, ti));
+         _mm256_storeu_ps(aRe+j, _mm256_add_ps(ar, tr));
+         _mm256_storeu_ps(aIm+j, _mm256_add_ps(ai, ti));
+      }
+   }
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+FftBackendFloat::FftBackendFloat(int numTaps, eKernel kernel):
+   FftBackend(numTaps),
+   m_numCpx(numTaps>>1),
+   m_kernel(E_KERNEL_SCALAR),
+   m_stageFunc(stage_scalar),
+   m_minStageHalf(1)
+{
+   assert(numTaps >= 8 && (numTaps & (numTaps-1)) == 0); // Must be a power of 2.
+
+#ifdef FFT_X86_KERNELS
+   if(kernel == E_KERNEL_AVX)
+   {
+      m_kernel = E_KERNEL_AVX;
+      m_stageFunc = stage_avx;
+      m_minStageHalf = 8;
+   }
+   else if(kernel == E_KERNEL_SSE)
+   {
+      m_kernel = E_KERNEL_SSE;
+      m_stageFunc = stage_sse;
+      m_minStageHalf = 4;
+   }
+#endif
+
+   // Bit reverse table.
+   int numBits = 0;
+   while((1 << numBits) < m_numCpx)
+      numBits++;
+   m_bitRev.resize(m_numCpx);
+   for(int i = 0; i < m_numCpx; ++i)
+   {
+      int rev = 0;
+      for(int bit = 0; bit < numBits; ++bit)
+      {
+         if(i & (1 << bit))
+            rev |= 1 << (numBits - 1 - bit);
+      }
+      m_bitRev[i] = rev;
+   }
+
+   // Per stage twiddles.
+   m_twiddleRe.resize(m_numCpx);
+   m_twiddleIm.resize(m_numCpx);
+   for(int half = 1; half < m_numCpx; half <<= 1)
+   {
+      for(int j = 0; j < half; ++j)
+      {
+         double angle = M_PI * (double)j / (double)half;
+         m_twiddleRe[half-1+j] =  cos(angle);
+         m_twiddleIm[half-1+j] = -sin(angle);
+      }
+   }
+
+   // Real FFT split twiddles.
+   m_splitRe.resize(m_numCpx);
+   m_splitIm.resize(m_numCpx);
+   for(int k = 0; k < m_numCpx; ++k)
+   {
+      double angle = 2.0 * M_PI * (double)k / (double)numTaps;
+      m_splitRe[k] =  cos(angle);
+      m_splitIm[k] = -sin(angle);
+   }
+
+   m_re.resize(m_numCpx);
+   m_im.resize(m_numCpx);
+}
+
+FftBackendFloat::~FftBackendFloat()
+{
+
+}
+
+FftBackendFloat::eKernel FftBackendFloat::fastestKernel()
+{
+   if(CpuFeatures::hasAvx())
+      return E_KERNEL_AVX;
+   else if(CpuFeatures::hasSse2())
+      return E_KERNEL_SSE;
+   return E_KERNEL_SCALAR;
+}
+
+const char* FftBackendFloat::getName()
+{
+   switch(m_kernel)
+   {
+      case E_KERNEL_AVX:
+         return "Float AVX";
+      case E_KERNEL_SSE:
+         return "Float SSE";
+      default:
+         break;
+   }
+   return "Float Scalar";
+}
+
+void FftBackendFloat::runFft(const int16_t* inSamp, tComplex* outBins)
+{
+   loadBitReversed(inSamp);
+   runFirstStages();
+   runStages();
+   splitRealFft(outBins);
+}
+
+void FftBackendFloat::runComplexFftPower(const float* inRe, const float* inIm, float* outPower)
+{
+   for(int i = 0; i < m_numCpx; ++i)
+   {
+      int sampIndex = m_bitRev[i];
+      m_re[i] = inRe[sampIndex];
+      m_im[i] = inIm[sampIndex];
+   }
+   runFirstStages();
+   runStages();
+
+   const float scale = 1.0f / (float)m_numCpx;
+   const float powerScale = scale * scale;
+   for(int k = 0; k < m_numCpx; ++k)
+   {
+      outPower[k] = (m_re[k]*m_re[k] + m_im[k]*m_im[k]) * powerScale;
+   }
+}
+
+void FftBackendFloat::setWindow(const std::vector<int16_t>& windowQ15)
+{
+   FftBackend::setWindow(windowQ15);
+
+   m_windowFlt.resize(windowQ15.size());
+   for(size_t i = 0; i < windowQ15.size(); ++i)
+   {
+      m_windowFlt[i] = (float)windowQ15[i] / 32768.0f;
+   }
+}
+
+void FftBackendFloat::runFftMag(const int16_t* inSamp, uint16_t* outMag)
+{
+   if(m_windowFlt.size() > 0)
+      loadBitReversedWindowed(inSamp);
+   else
+      loadBitReversed(inSamp);
+   runFirstStages();
+   runStages();
+   splitRealFftMag(outMag);
+}
+
+void FftBackendFloat::runFftPower(const int16_t* inSamp, float* outPower)
+{
+   if(m_windowFlt.size() > 0)
+      loadBitReversedWindowed(inSamp);
+   else
+      loadBitReversed(inSamp);
+   runFirstStages();
+   runStages();
+   splitRealFftPower(outPower);
+}
+
+void FftBackendFloat::loadBitReversedWindowed(const int16_t* inSamp)
+{
+   // Same as loadBitReversed, but the window multiply is folded in.
+   const float* window = m_windowFlt.data();
+   for(int i = 0; i < m_numCpx; ++i)
+   {
+      int sampIndex = m_bitRev[i]<<1;
+      m_re[i] = (float)inSamp[sampIndex  ] * window[sampIndex  ];
+      m_im[i] = (float)inSamp[sampIndex+1] * window[sampIndex+1];
+   }
+}
+
+void FftBackendFloat::loadBitReversed(const int16_t* inSamp)
+{
+   // Even samples go in the real part, odd samples go in the imaginary part.
+   for(int i = 0; i < m_numCpx; ++i)
+   {
+      const int16_t* samp = &inSamp[m_bitRev[i]<<1];
+      m_re[i] = samp[0];
+      m_im[i] = samp[1];
+   }
+}
+
+void FftBackendFloat::runFirstStages()
+{
+   // The first 2 radix 2 stages only have twiddles of 1 and -j, so do them as a single radix 4 pass.
+   float* re = m_re.data();
+   float* im = m_im.data();
+   for(int i = 0; i < m_numCpx; i += 4)
+   {
+      float a0r = re[i+0] + re[i+1];
+      float a0i = im[i+0] + im[i+1];
+      float a1r = re[i+0] - re[i+1];
+      float a1i = im[i+0] - im[i+1];
+      float a2r = re[i+2] + re[i+3];
+      float a2i = im[i+2] + im[i+3];
+      float a3r = re[i+2] - re[i+3];
+      float a3i = im[i+2] - im[i+3];
+
+      re[i+0] = a0r + a2r;
+      im[i+0] = a0i + a2i;
+      re[i+2] = a0r - a2r;
+      im[i+2] = a0i - a2i;
+      re[i+1] = a1r + a3i; // a3 * -j = a3i - j*a3r
+      im[i+1] = a1i - a3r;
+      re[i+3] = a1r - a3i;
+      im[i+3] = a1i + a3r;
+   }
+}
+
+void FftBackendFloat::runStages()
+{
+   for(int half = 4; half < m_numCpx; half <<= 1)
+   {
+      tStageFunc func = (half >= m_minStageHalf) ? m_stageFunc : stage_scalar;
+      func(m_re.data(), m_im.data(), &m_twiddleRe[half-1], &m_twiddleIm[half-1], m_numCpx, half);
+   }
+}
+
+inline void FftBackendFloat::splitStep(int k, float& xr, float& xi)
+{
+   int n = m_numCpx - k;
+   float er = m_re[k] + m_re[n]; // Even samples' FFT (times 2)
+   float ei = m_im[k] - m_im[n];
+   float dr = m_re[k] - m_re[n]; // Odd samples' FFT (times 2j)
+   float di = m_im[k] + m_im[n];
+
+   float wr = m_splitRe[k];
+   float wi = m_splitIm[k];
+   xr = er + wr*di + wi*dr;
+   xi = ei - wr*dr + wi*di;
+}
+
+void FftBackendFloat::splitRealFft(tComplex* outBins)
+{
+   const float scale = 1.0f / (float)m_numTaps;
+   const float halfScale = 0.5f * scale;
+
+   // DC and Nyquist only depend on the first complex bin.
+   outBins[0].r = floatToInt16((m_re[0] + m_im[0]) * scale);
+   outBins[0].i = 0;
+   outBins[m_numCpx].r = floatToInt16((m_re[0] - m_im[0]) * scale);
+   outBins[m_numCpx].i = 0;
+
+   for(int k = 1; k < m_numCpx; ++k)
+   {
+      float xr, xi;
+      splitStep(k, xr, xi);
+      outBins[k].r = floatToInt16(xr * halfScale);
+      outBins[k].i = floatToInt16(xi * halfScale);
+   }
+}
+
+void FftBackendFloat::splitRealFftMag(uint16_t* outMag)
+{
+   const float scale = 1.0f / (float)m_numTaps;
+   const float halfScale = 0.5f * scale;
+
+   outMag[0] = floatToUint16(fabsf(m_re[0] + m_im[0]) * scale);
+
+   int k = 1;
+#ifdef FFT_X86_KERNELS
+   if(m_kernel != E_KERNEL_SCALAR)
+      k = splitMag_sse(m_re.data(), m_im.data(), m_splitRe.data(), m_splitIm.data(), m_numCpx, halfScale, outMag);
+#endif
+
+   for(; k < m_numCpx; ++k)
+   {
+      float xr, xi;
+      splitStep(k, xr, xi);
+      outMag[k] = floatToUint16(sqrtf(xr*xr + xi*xi) * halfScale);
+   }
+}
+
+void FftBackendFloat::splitRealFftPower(float* outPower)
+{
+   const float scale = 1.0f / (float)m_numTaps;
+   const float halfScale = 0.5f * scale;
+   const float powerScale = halfScale * halfScale;
+
+   float dc = (m_re[0] + m_im[0]) * scale;
+   outPower[0] = dc * dc;
+
+   int k = 1;
+#ifdef FFT_X86_KERNELS
+   if(m_kernel != E_KERNEL_SCALAR)
+      k = splitPower_sse(m_re.data(), m_im.data(), m_splitRe.data(), m_splitIm.data(), m_numCpx, halfScale, outPower);
+#endif
+
+   for(; k < m_numCpx; ++k)
+   {
+      float xr, xi;
+      splitStep(k, xr, xi);
+      outPower[k] = (xr*xr + xi*xi) * powerScale;
+   }
+}
+
@@ -0,0 +1,97 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <vector>
+#include "fftBackend.h"
+
+// Portable floating point real FFT. The real FFT is done via a complex FFT of half the size
+// (even samples in the real part, odd samples in the imaginary part) followed by a split step
+// that separates the two. The complex FFT is an iterative radix 2 with the first two stages
+// merged (no twiddle multiplies needed there). The remaining stages can be run with plain C,
+// SSE or AVX butterflies.
+//
+// runFftMag is fused: the window is applied while loading the bit reversed input and the
+// magnitude (or power) is computed directly from the float split step (no int16 round trip).
+class FftBackendFloat : public FftBackend
+{
+public:
+   typedef enum
+   {
+      E_KERNEL_SCALAR,
+      E_KERNEL_SSE,
+      E_KERNEL_AVX
+   }eKernel;
+
+   FftBackendFloat(int numTaps, eKernel kernel);
+   virtual ~FftBackendFloat();
+
+   void runFft(const int16_t* inSamp, tComplex* outBins) override;
+   void runFftMag(const int16_t* inSamp, uint16_t* outMag) override;
+   void runFftPower(const int16_t* inSamp, float* outPower) override;
+   void setWindow(const std::vector<int16_t>& windowQ15) override;
+
+   const char* getName() override;
+
+   // Complex FFT of numTaps/2 complex samples (any window already applied). Writes the power of
+   // each bin (scaled the same as the real FFT) in natural order, i.e. DC first.
+   void runComplexFftPower(const float* inRe, const float* inIm, float* outPower);
+
+   // Best kernel for this CPU.
+   static eKernel fastestKernel();
+
+private:
+   // Make uncopyable
+   FftBackendFloat();
+   FftBackendFloat(FftBackendFloat const&);
+   void operator=(FftBackendFloat const&);
+
+   typedef void (*tStageFunc)(float* re, float* im, const float* twRe, const float* twIm, int numCpx, int half);
+
+   int m_numCpx; // Size of the complex FFT (i.e. half the number of real taps).
+   eKernel m_kernel;
+   tStageFunc m_stageFunc;
+   int m_minStageHalf; // Smallest stage (in butterflies per group) the SIMD kernel can handle.
+
+   std::vector<int> m_bitRev;
+
+   // Twiddles for every stage, back to back. The stage with 'half' butterflies per group starts at index 'half-1'.
+   std::vector<float> m_twiddleRe;
+   std::vector<float> m_twiddleIm;
+
+   // Twiddles for separating the real FFT from the complex FFT.
+   std::vector<float> m_splitRe;
+   std::vector<float> m_splitIm;
+
+   // Working buffers (split real / imaginary so the butterflies vectorize).
+   std::vector<float> m_re;
+   std::vector<float> m_im;
+
+   std::vector<float> m_windowFlt;
+
+   void loadBitReversed(const int16_t* inSamp);
+   void loadBitReversedWindowed(const int16_t* inSamp);
+   void runFirstStages();
+   void runStages();
+   inline void splitStep(int k, float& xr, float& xi);
+   void splitRealFft(tComplex* outBins);
+   void splitRealFftMag(uint16_t* outMag);
+   void splitRealFftPower(float* outPower);
+};
+
@@ -0,0 +1,329 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <math.h>
+#include <time.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <linux/perf_event.h>
+#include <vector>
+#include <memory>
+#include <algorithm> // std::max
+#include "fftBenchmark.h"
+#include "fftBackend.h"
+#include "fftKernels.h"
+#include "specAnFft.h"
+#include "fastMath.h"
+
+#define NUM_BENCHMARK_FFTS (20000)
+#define NUM_FAST_MATH_VALUES (1024)
+#define NUM_FAST_MATH_RUNS (2000)
+
+// Signal levels for the precision SNR measurements (dB relative to int16 full scale).
+static const double PRECISION_LEVELS_DB[] = {-6.0, -30.0, -50.0, -70.0};
+
+// Reads the CPU cycle counter via the Linux perf interface (works on ARM and x86).
+// If perf isn't available only the wall clock time is reported.
+class CycleCounter
+{
+public:
+   CycleCounter()
+   {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      m_fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+   }
+   ~CycleCounter()
+   {
+      if(m_fd >= 0)
+         close(m_fd);
+   }
+
+   void start()
+   {
+      if(m_fd >= 0)
+      {
+         ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+         ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+      clock_gettime(CLOCK_MONOTONIC, &m_startTime);
+   }
+
+   // Returns false if the cycle count isn't available.
+   bool stop(long long& cycles, double& nanoSec)
+   {
+      struct timespec stopTime;
+      clock_gettime(CLOCK_MONOTONIC, &stopTime);
+      nanoSec = (double)(stopTime.tv_sec - m_startTime.tv_sec) * 1e9 + (double)(stopTime.tv_nsec - m_startTime.tv_nsec);
+
+      cycles = 0;
+      if(m_fd >= 0)
+      {
+         ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+         if(read(m_fd, &cycles, sizeof(cycles)) != sizeof(cycles))
+            return false;
+         return true;
+      }
+      return false;
+   }
+
+private:
+   int m_fd;
+   struct timespec m_startTime;
+};
+
+static void printResult(const char* name, CycleCounter& counter, double numRuns = NUM_BENCHMARK_FFTS, const char* unit = "FFT")
+{
+   long long cycles;
+   double nanoSec;
+   if(counter.stop(cycles, nanoSec))
+      printf("   %-22s %10.1f cycles/%s %10.2f ns/%s\n", name, (double)cycles / numRuns, unit, nanoSec / numRuns, unit);
+   else
+      printf("   %-22s %10s cycles/%s %10.2f ns/%s\n", name, "n/a", unit, nanoSec / numRuns, unit);
+}
+
+void FftBenchmark::run(int fftSize)
+{
+   static const FftBackend::eBackendType backends[] = {FftBackend::E_BACKEND_NE10, FftBackend::E_BACKEND_FLOAT_SCALAR, FftBackend::E_BACKEND_FLOAT_SSE, FftBackend::E_BACKEND_FLOAT_AVX};
+
+   // Test signal, a couple of tones plus some noise.
+   std::vector<int16_t> input(fftSize);
+   for(int i = 0; i < fftSize; ++i)
+   {
+      input[i] = 8000.0 * sin(0.05 * i) + 3000.0 * sin(0.77 * i) + (rand() % 512) - 256;
+   }
+
+   std::vector<int16_t> windowed(fftSize);
+   std::vector<FftBackend::tComplex> bins((fftSize>>1)+1);
+   std::vector<uint16_t> magBefore(fftSize>>1);
+   std::vector<uint16_t> magAfter(fftSize>>1);
+
+   printf("FFT Benchmark - %d point FFT, %d runs\n", fftSize, NUM_BENCHMARK_FFTS);
+   CycleCounter counter;
+   for(auto backendType : backends)
+   {
+      auto backend = FftBackend::create(fftSize, backendType);
+      if(backend.get() == nullptr)
+         continue; // Not available on this CPU.
+      SpecAnFft fused(fftSize, WindowTables::E_WINDOW_BLACKMAN_HARRIS, backendType);
+      auto& window = fused.getWindowCoefs();
+
+      printf(" %s\n", backend->getName());
+
+      // Before: 3 separate scalar passes.
+      counter.start();
+      for(int run = 0; run < NUM_BENCHMARK_FFTS; ++run)
+      {
+         FftKernels::applyWindow_scalar(input.data(), window.data(), windowed.data(), fftSize);
+         backend->runFft(windowed.data(), bins.data());
+         FftKernels::magnitude_scalar(bins.data(), magBefore.data(), fftSize>>1);
+      }
+      printResult("3 pass (before)", counter);
+
+      // After: fused window + FFT + magnitude.
+      counter.start();
+      for(int run = 0; run < NUM_BENCHMARK_FFTS; ++run)
+      {
+         fused.runFft(input.data(), magAfter.data());
+      }
+      printResult("Fused (after)", counter);
+
+      int maxDiff = 0;
+      for(int i = 0; i < (fftSize>>1); ++i)
+      {
+         maxDiff = std::max(maxDiff, abs((int)magBefore[i] - (int)magAfter[i]));
+      }
+      printf("   Max magnitude difference: %d\n", maxDiff);
+   }
+}
+
+// Same units as runFftPower (scaled by 1/fftSize), computed with a double precision DFT.
+static void referencePower(const std::vector<int16_t>& input, const std::vector<int16_t>& window, std::vector<double>& power)
+{
+   int fftSize = input.size();
+   power.resize(fftSize>>1);
+   for(int k = 0; k < (fftSize>>1); ++k)
+   {
+      double re = 0.0;
+      double im = 0.0;
+      for(int i = 0; i < fftSize; ++i)
+      {
+         double samp = (double)input[i] * (double)window[i] / 32768.0;
+         double angle = -2.0 * M_PI * (double)k * (double)i / (double)fftSize;
+         re += samp * cos(angle);
+         im += samp * sin(angle);
+      }
+      re /= fftSize;
+      im /= fftSize;
+      power[k] = re*re + im*im;
+   }
+}
+
+// Magnitude error energy relative to the total signal energy, in dB.
+static double measureSnr(const std::vector<double>& refPower, const std::vector<float>& power)
+{
+   double signal = 0.0;
+   double error = 0.0;
+   for(size_t k = 0; k < refPower.size(); ++k)
+   {
+      double diff = sqrt((double)power[k]) - sqrt(refPower[k]);
+      signal += refPower[k];
+      error += diff * diff;
+   }
+   if(error <= 0.0)
+      return 999.0;
+   return 10.0 * log10(signal / error);
+}
+
+void FftBenchmark::runPrecision(int fftSize)
+{
+   static const FftBackend::ePrecision precisions[] = {FftBackend::E_PRECISION_INT16, FftBackend::E_PRECISION_INT32_BFP, FftBackend::E_PRECISION_FLOAT};
+   static const int numLevels = sizeof(PRECISION_LEVELS_DB) / sizeof(PRECISION_LEVELS_DB[0]);
+
+   // Same test signal as 'run', at each level. Two tones, no noise (so quiet levels stay quiet).
+   std::vector<std::vector<int16_t>> inputs(numLevels, std::vector<int16_t>(fftSize));
+   for(int level = 0; level < numLevels; ++level)
+   {
+      double amp = 32767.0 * pow(10.0, PRECISION_LEVELS_DB[level] / 20.0);
+      for(int i = 0; i < fftSize; ++i)
+         inputs[level][i] = lrint(amp * (0.7 * sin(0.05 * i) + 0.3 * sin(0.77 * i)));
+   }
+
+   std::vector<float> power(fftSize>>1);
+   std::vector<double> refPower;
+
+   printf("FFT Precision - %d point FFT, %d runs, SNR vs double precision at", fftSize, NUM_BENCHMARK_FFTS);
+   for(int level = 0; level < numLevels; ++level)
+      printf(" %.0f", PRECISION_LEVELS_DB[level]);
+   printf(" dBFS\n");
+
+   CycleCounter counter;
+   for(auto precision : precisions)
+   {
+      SpecAnFft fft(fftSize, WindowTables::E_WINDOW_BLACKMAN_HARRIS, FftBackend::getBackendType(precision));
+      printf(" %s (%s)\n", FftBackend::getPrecisionName(precision), fft.getBackendName());
+
+      counter.start();
+      for(int run = 0; run < NUM_BENCHMARK_FFTS; ++run)
+      {
+         fft.runFftPower(inputs[0].data(), power.data());
+      }
+      printResult("runFftPower", counter);
+
+      printf("   SNR (dB):");
+      for(int level = 0; level < numLevels; ++level)
+      {
+         referencePower(inputs[level], fft.getWindowCoefs(), refPower);
+         fft.runFftPower(inputs[level].data(), power.data());
+         printf(" %7.1f", measureSnr(refPower, power));
+      }
+      printf("\n");
+   }
+}
+
+// Runs the C library function, the FastMath scalar function and the FastMath batch function over
+// the same inputs and prints the time per value and the max error (relative or absolute).
+template<typename tLibFunc, typename tFastFunc, typename tBatchFunc>
+static void compareFastMath(const char* name, const std::vector<float>& input, tLibFunc libFunc, tFastFunc fastFunc, tBatchFunc batchFunc, bool relativeError)
+{
+   static const double numValues = (double)NUM_FAST_MATH_VALUES * NUM_FAST_MATH_RUNS;
+   std::vector<float> libOut(input.size());
+   std::vector<float> fastOut(input.size());
+   std::vector<float> batchOut(input.size());
+   CycleCounter counter;
+
+   printf(" %s\n", name);
+   counter.start();
+   for(int run = 0; run < NUM_FAST_MATH_RUNS; ++run)
+   {
+      for(size_t i = 0; i < input.size(); ++i)
+         libOut[i] = libFunc(input[i]);
+   }
+   printResult("C library", counter, numValues, "value");
+
+   counter.start();
+   for(int run = 0; run < NUM_FAST_MATH_RUNS; ++run)
+   {
+      for(size_t i = 0; i < input.size(); ++i)
+         fastOut[i] = fastFunc(input[i]);
+   }
+   printResult("FastMath", counter, numValues, "value");
+
+   counter.start();
+   for(int run = 0; run < NUM_FAST_MATH_RUNS; ++run)
+   {
+      batchFunc(input.data(), batchOut.data(), input.size());
+   }
+   printResult("FastMath batch", counter, numValues, "value");
+
+   double maxError = 0.0;
+   for(size_t i = 0; i < input.size(); ++i)
+   {
+      double ref = libOut[i];
+      double errors[] = {fabs(fastOut[i] - ref), fabs(batchOut[i] - ref)};
+      for(double error : errors)
+      {
+         if(relativeError && ref != 0.0)
+            error /= fabs(ref);
+         maxError = std::max(maxError, error);
+      }
+   }
+   printf("   Max %s error: %.2e\n", relativeError ? "relative" : "absolute", maxError);
+}
+
+void FftBenchmark::runFastMath()
+{
+   // Same kinds of values the display code passes in.
+   std::vector<float> logIn(NUM_FAST_MATH_VALUES);   // FFT power / magnitude
+   std::vector<float> unitIn(NUM_FAST_MATH_VALUES);  // Brightness, 0 to 1
+   std::vector<float> sqrtIn(NUM_FAST_MATH_VALUES);  // Sum of squared RGB values
+   for(int i = 0; i < NUM_FAST_MATH_VALUES; ++i)
+   {
+      logIn[i] = 1.0f + (float)(rand() % 100000000);
+      unitIn[i] = (float)rand() / (float)RAND_MAX;
+      sqrtIn[i] = (float)(rand() % (3*255*255));
+   }
+
+   printf("Fast Math Benchmark - %d values, %d runs\n", NUM_FAST_MATH_VALUES, NUM_FAST_MATH_RUNS);
+   compareFastMath("log", logIn,
+                   [](float x){return logf(x);},
+                   [](float x){return FastMath::log(x);},
+                   [](const float* in, float* out, int num){FastMath::log(in, out, num);}, false);
+   compareFastMath("pow(x, 1.8)", unitIn,
+                   [](float x){return powf(x, 1.8f);},
+                   [](float x){return FastMath::pow(x, 1.8f);},
+                   [](const float* in, float* out, int num){FastMath::pow(in, 1.8f, out, num);}, true);
+   compareFastMath("sqrt", sqrtIn,
+                   [](float x){return sqrtf(x);},
+                   [](float x){return FastMath::sqrt(x);},
+                   [](const float* in, float* out, int num){FastMath::sqrt(in, out, num);}, true);
+   compareFastMath("1 / sqrt", logIn,
+                   [](float x){return 1.0f / sqrtf(x);},
+                   [](float x){return FastMath::invSqrt(x);},
+                   [](const float* in, float* out, int num){for(int i = 0; i < num; ++i) out[i] = FastMath::invSqrt(in[i]);}, true);
+}
@@ -0,0 +1,250 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include "fftKernels.h"
+#include "cpuFeatures.h"
+#include "fastMath.h"
+
+#if defined(__ARM_NEON)
+#define FFT_NEON_KERNELS
+#include <arm_neon.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#define FFT_SSE_KERNELS
+#include <immintrin.h>
+#endif
+
+static uint16_t magnatude(const int16_t* complexSample)
+{
+   float squared = (int32_t)complexSample[0] * (int32_t)complexSample[0] + (int32_t)complexSample[1] * (int32_t)complexSample[1];
+   uint16_t result = (uint16_t)(squared * FastMath::invSqrt(squared) + 0.5f); // sqrt(x) = x / sqrt(x), no square root or divide.
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Window
+////////////////////////////////////////////////////////////////////////////////
+void FftKernels::applyWindow_scalar(const int16_t* in, const int16_t* windowQ15, int16_t* out, int num)
+{
+   for(int i = 0; i < num; ++i)
+   {
+      out[i] = ((int32_t)in[i] * (int32_t)windowQ15[i]) >> 15;
+   }
+}
+
+#ifdef FFT_SSE_KERNELS
+__attribute__((target("sse2")))
+static void applyWindow_sse(const int16_t* in, const int16_t* windowQ15, int16_t* out, int num)
+{
+   int i = 0;
+   for(; i + 8 <= num; i += 8)
+   {
+      __m128i x = _mm_loadu_si128((const __m128i*)&in[i]);
+      __m128i w = _mm_loadu_si128((const __m128i*)&windowQ15[i]);
+      __m128i lo = _mm_mullo_epi16(x, w);
+      __m128i hi = _mm_mulhi_epi16(x, w);
+      __m128i prod0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+      __m128i prod1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+      _mm_storeu_si128((__m128i*)&out[i], _mm_packs_epi32(prod0, prod1));
+   }
+   FftKernels::applyWindow_scalar(in+i, windowQ15+i, out+i, num-i);
+}
+#endif
+
+#ifdef FFT_NEON_KERNELS
+static void applyWindow_neon(const int16_t* in, const int16_t* windowQ15, int16_t* out, int num)
+{
+   int i = 0;
+   for(; i + 8 <= num; i += 8)
+   {
+      int16x8_t x = vld1q_s16(&in[i]);
+      int16x8_t w = vld1q_s16(&windowQ15[i]);
+      int32x4_t prod0 = vmull_s16(vget_low_s16(x), vget_low_s16(w));
+      int32x4_t prod1 = vmull_s16(vget_high_s16(x), vget_high_s16(w));
+      vst1q_s16(&out[i], vcombine_s16(vshrn_n_s32(prod0, 15), vshrn_n_s32(prod1, 15)));
+   }
+   FftKernels::applyWindow_scalar(in+i, windowQ15+i, out+i, num-i);
+}
+#endif
+
+void FftKernels::applyWindow(const int16_t* in, const int16_t* windowQ15, int16_t* out, int num)
+{
+#if defined(FFT_NEON_KERNELS)
+   applyWindow_neon(in, windowQ15, out, num);
+#elif defined(FFT_SSE_KERNELS)
+   static const bool sse2 = CpuFeatures::hasSse2();
+   if(sse2)
+      applyWindow_sse(in, windowQ15, out, num);
+   else
+      applyWindow_scalar(in, windowQ15, out, num);
+#else
+   applyWindow_scalar(in, windowQ15, out, num);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Magnitude
+////////////////////////////////////////////////////////////////////////////////
+void FftKernels::magnitude_scalar(const FftBackend::tComplex* bins, uint16_t* out, int num)
+{
+   for(int i = 0; i < num; ++i)
+   {
+      out[i] = magnatude((const int16_t*)&bins[i]);
+   }
+}
+
+#ifdef FFT_SSE_KERNELS
+__attribute__((target("sse2")))
+static void magnitude_sse(const FftBackend::tComplex* bins, uint16_t* out, int num)
+{
+   const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+   const __m128 half = _mm_set1_ps(0.5f);
+   const __m128 maxU16 = _mm_set1_ps(65535.0f);
+   const __m128i bias32 = _mm_set1_epi32(0x8000);
+   const __m128i bias16 = _mm_set1_epi16((int16_t)0x8000);
+
+   int i = 0;
+   for(; i + 8 <= num; i += 8) // 8 bins per loop.
+   {
+      __m128i cpx0 = _mm_loadu_si128((const __m128i*)&bins[i]);
+      __m128i cpx1 = _mm_loadu_si128((const __m128i*)&bins[i+4]);
+
+      // r*r + i*i per complex value in a single instruction. The only value that can overflow is
+      // (-32768)^2 * 2 which becomes 0x80000000, the float abs() below fixes that case up.
+      __m128 sq0 = _mm_and_ps(_mm_cvtepi32_ps(_mm_madd_epi16(cpx0, cpx0)), absMask);
+      __m128 sq1 = _mm_and_ps(_mm_cvtepi32_ps(_mm_madd_epi16(cpx1, cpx1)), absMask);
+
+      __m128 mag0 = _mm_min_ps(_mm_add_ps(_mm_sqrt_ps(sq0), half), maxU16);
+      __m128 mag1 = _mm_min_ps(_mm_add_ps(_mm_sqrt_ps(sq1), half), maxU16);
+
+      // No unsigned saturating pack in SSE2, so shift to signed, pack, then shift back.
+      __m128i int0 = _mm_sub_epi32(_mm_cvttps_epi32(mag0), bias32);
+      __m128i int1 = _mm_sub_epi32(_mm_cvttps_epi32(mag1), bias32);
+      _mm_storeu_si128((__m128i*)&out[i], _mm_add_epi16(_mm_packs_epi32(int0, int1), bias16));
+   }
+   FftKernels::magnitude_scalar(bins+i, out+i, num-i);
+}
+#endif
+
+#ifdef FFT_NEON_KERNELS
+static void magnitude_neon(const FftBackend::tComplex* bins, uint16_t* out, int num)
+{
+   const float32x4_t one = vdupq_n_f32(1.0f);
+   const float32x4_t half = vdupq_n_f32(0.5f);
+
+   int i = 0;
+   for(; i + 8 <= num; i += 8) // 8 bins per loop.
+   {
+      int16x8x2_t cpx = vld2q_s16((const int16_t*)&bins[i]); // De-interleave real / imag.
+
+      // r*r + i*i can be up to 2^31, so treat the 32 bit result as unsigned.
+      int32x4_t sqInt0 = vmlal_s16(vmull_s16(vget_low_s16(cpx.val[0]), vget_low_s16(cpx.val[0])), vget_low_s16(cpx.val[1]), vget_low_s16(cpx.val[1]));
+      int32x4_t sqInt1 = vmlal_s16(vmull_s16(vget_high_s16(cpx.val[0]), vget_high_s16(cpx.val[0])), vget_high_s16(cpx.val[1]), vget_high_s16(cpx.val[1]));
+      float32x4_t sq0 = vcvtq_f32_u32(vreinterpretq_u32_s32(sqInt0));
+      float32x4_t sq1 = vcvtq_f32_u32(vreinterpretq_u32_s32(sqInt1));
+
+      // sqrt(x) = x * invSqrt(x). Estimate then 2 Newton iterations (same idea as the Quake method).
+      // Clamp the estimate input to 1 to avoid 0 * inf.
+      float32x4_t est0 = vrsqrteq_f32(vmaxq_f32(sq0, one));
+      float32x4_t est1 = vrsqrteq_f32(vmaxq_f32(sq1, one));
+      est0 = vmulq_f32(est0, vrsqrtsq_f32(vmulq_f32(sq0, est0), est0));
+      est1 = vmulq_f32(est1, vrsqrtsq_f32(vmulq_f32(sq1, est1), est1));
+      est0 = vmulq_f32(est0, vrsqrtsq_f32(vmulq_f32(sq0, est0), est0));
+      est1 = vmulq_f32(est1, vrsqrtsq_f32(vmulq_f32(sq1, est1), est1));
+
+      uint32x4_t mag0 = vcvtq_u32_f32(vaddq_f32(vmulq_f32(sq0, est0), half));
+      uint32x4_t mag1 = vcvtq_u32_f32(vaddq_f32(vmulq_f32(sq1, est1), half));
+      vst1q_u16(&out[i], vcombine_u16(vqmovn_u32(mag0), vqmovn_u32(mag1)));
+   }
+   FftKernels::magnitude_scalar(bins+i, out+i, num-i);
+}
+#endif
+
+void FftKernels::magnitude(const FftBackend::tComplex* bins, uint16_t* out, int num)
+{
+#if defined(FFT_NEON_KERNELS)
+   magnitude_neon(bins, out, num);
+#elif defined(FFT_SSE_KERNELS)
+   static const bool sse2 = CpuFeatures::hasSse2();
+   if(sse2)
+      magnitude_sse(bins, out, num);
+   else
+      magnitude_scalar(bins, out, num);
+#else
+   magnitude_scalar(bins, out, num);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Power (Squared Magnitude)
+////////////////////////////////////////////////////////////////////////////////
+void FftKernels::power_scalar(const FftBackend::tComplex* bins, float* out, int num)
+{
+   for(int i = 0; i < num; ++i)
+   {
+      uint32_t squared = (uint32_t)((int32_t)bins[i].r * (int32_t)bins[i].r) + (uint32_t)((int32_t)bins[i].i * (int32_t)bins[i].i);
+      out[i] = (float)squared;
+   }
+}
+
+#ifdef FFT_SSE_KERNELS
+__attribute__((target("sse2")))
+static void power_sse(const FftBackend::tComplex* bins, float* out, int num)
+{
+   const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+   int i = 0;
+   for(; i + 4 <= num; i += 4)
+   {
+      __m128i cpx = _mm_loadu_si128((const __m128i*)&bins[i]);
+      _mm_storeu_ps(&out[i], _mm_and_ps(_mm_cvtepi32_ps(_mm_madd_epi16(cpx, cpx)), absMask)); // See magnitude_sse for why abs().
+   }
+   FftKernels::power_scalar(bins+i, out+i, num-i);
+}
+#endif
+
+#ifdef FFT_NEON_KERNELS
+static void power_neon(const FftBackend::tComplex* bins, float* out, int num)
+{
+   int i = 0;
+   for(; i + 8 <= num; i += 8)
+   {
+      int16x8x2_t cpx = vld2q_s16((const int16_t*)&bins[i]); // De-interleave real / imag.
+      int32x4_t sqInt0 = vmlal_s16(vmull_s16(vget_low_s16(cpx.val[0]), vget_low_s16(cpx.val[0])), vget_low_s16(cpx.val[1]), vget_low_s16(cpx.val[1]));
+      int32x4_t sqInt1 = vmlal_s16(vmull_s16(vget_high_s16(cpx.val[0]), vget_high_s16(cpx.val[0])), vget_high_s16(cpx.val[1]), vget_high_s16(cpx.val[1]));
+      vst1q_f32(&out[i  ], vcvtq_f32_u32(vreinterpretq_u32_s32(sqInt0)));
+      vst1q_f32(&out[i+4], vcvtq_f32_u32(vreinterpretq_u32_s32(sqInt1)));
+   }
+   FftKernels::power_scalar(bins+i, out+i, num-i);
+}
+#endif
+
+void FftKernels::power(const FftBackend::tComplex* bins, float* out, int num)
+{
+#if defined(FFT_NEON_KERNELS)
+   power_neon(bins, out, num);
+#elif defined(FFT_SSE_KERNELS)
+   static const bool sse2 = CpuFeatures::hasSse2();
+   if(sse2)
+      power_sse(bins, out, num);
+   else
+      power_scalar(bins, out, num);
+#else
+   power_scalar(bins, out, num);
+#endif
+}
+
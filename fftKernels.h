@@ -0,0 +1,40 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "fftBackend.h"
+
+// Vectorized helpers for the stages around the FFT. NEON is used when the build
+// targets NEON, SSE2 is used on x86. Everything else gets the plain C version.
+namespace FftKernels
+{
+   // out[i] = (in[i] * windowQ15[i]) >> 15
+   void applyWindow(const int16_t* in, const int16_t* windowQ15, int16_t* out, int num);
+   void applyWindow_scalar(const int16_t* in, const int16_t* windowQ15, int16_t* out, int num);
+
+   // out[i] = |bins[i]| (rounded, saturated to 0xFFFF)
+   void magnitude(const FftBackend::tComplex* bins, uint16_t* out, int num);
+   void magnitude_scalar(const FftBackend::tComplex* bins, uint16_t* out, int num);
+
+   // out[i] = |bins[i]|^2
+   void power(const FftBackend::tComplex* bins, float* out, int num);
+   void power_scalar(const FftBackend::tComplex* bins, float* out, int num);
+}
+
@@ -1,185 +1,442 @@
-/* Copyright 2020 Dan Williams. All Rights Reserved.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy of this
- * software and associated documentation files (the "Software"), to deal in the Software
- * without restriction, including without limitation the rights to use, copy, modify, merge,
- * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
- * to whom the Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all copies or
- * substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
- * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
- * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
- * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
- * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-#include <math.h>
-#include "fftModifier.h"
-
-
-FftModifier::FftModifier(float samplesRate, int fftSize, int numOutputValues, tFftModifiers& modifiers):
-   m_freqRange(samplesRate / 2.0),
-   m_hzPerBin(samplesRate/((float)fftSize)),
-   m_logScale(modifiers.logScale),
-   m_fadeAwayPeak(numOutputValues, 0),
-   m_fadeAwayCountDown(numOutputValues, 0),
-   m_fadeAwayAmount(modifiers.fadeAwayAmount)
-{
-   initIndexMap(samplesRate, fftSize, numOutputValues, modifiers);
-   initScale(modifiers, numOutputValues);
-}
-
-FftModifier::~FftModifier()
-{
-
-}
-
-int FftModifier::modify(uint16_t* inOut)
-{
-   int numOuts = m_indexMap.size()-1;
-   for(int outIndex = 0; outIndex < numOuts; ++outIndex)
-   {
-      int32_t sum = 0;
-      int numInSum = 0;
-      for(int inIndex = m_indexMap[outIndex]; inIndex < m_indexMap[outIndex+1]; ++inIndex)
-      {
-         sum += inOut[inIndex];
-         numInSum++;
-      }
-      sum /= numInSum;
-
-      sum = ((sum - m_offset) * m_scalar[outIndex]) >> 15;
-      
-      if(sum > 0xFFFF) sum = 0xFFFF;
-      else if(sum < 0) sum = 0;
-      inOut[outIndex] = sum;
-   }
-   if(m_logScale)
-      logScale(inOut, numOuts);
-
-   if(m_fadeAwayAmount > 0)
-      fadeAway(inOut, numOuts);
-
-   return numOuts;
-}
-
-void FftModifier::fadeAway(uint16_t* inOut, int num)
-{
-   for(int i = 0; i < num; ++i)
-   {
-      uint16_t fadeValue = 0;
-      if(m_fadeAwayCountDown[i] > 0)
-      {
-         if(m_fadeAwayPeak[i] > inOut[i])
-         {
-            fadeValue = m_fadeAwayPeak[i] * m_fadeAwayCountDown[i] / m_fadeAwayAmount;
-         }
-         // Else no need to calculate fadeValue, it will be less than the new value.
-         m_fadeAwayCountDown[i]--;
-      }
-
-      if(fadeValue > inOut[i])
-      {
-         inOut[i] = fadeValue;
-      }
-      else
-      {
-         m_fadeAwayPeak[i] = inOut[i];
-         m_fadeAwayCountDown[i] = m_fadeAwayAmount - 1;
-      }
-   }
-}
-
-void FftModifier::logScale(uint16_t* inOut, int num)
-{
-   static constexpr float maxU16 = (float)0xFFFF;
-   static constexpr float scalar = maxU16 / 4.8165; // log(0xFFFF) ~= 4.8165 (make sure to round up so scaler is slightly smaller)
-   for(int i = 0; i < num; ++i)
-   {
-      if(inOut[i] == 0) inOut[i] = 1; // Log of 0 is invalid, set to 1 to avoid.
-
-      inOut[i] = logf((float)inOut[i]) * scalar;
-   }
-}
-
-float FftModifier::spliceToFreq(float splice, float range, bool isStop)
-{
-   float value = isStop ? range + splice : splice;
-   while(value < 0) value += range;
-   while(value > range) value -= range;
-   return value;
-}
-
-void FftModifier::initIndexMap(float samplesRate, int fftSize, int numOutputValues, tFftModifiers& modifiers)
-{
-   m_indexMap.resize(numOutputValues+1);
-
-   float startFreq = spliceToFreq(modifiers.startFreq, m_freqRange, false);
-   float stopFreq  = spliceToFreq(modifiers.stopFreq,  m_freqRange, true);
-
-   float hzPerOutput = (stopFreq-startFreq) / numOutputValues;
-
-   float binsPerOutput = hzPerOutput / m_hzPerBin;
-   float startBin = startFreq / m_hzPerBin;
-
-   for(int i = 0; i < (numOutputValues+1); ++i)
-   {
-      m_indexMap[i] = startBin + binsPerOutput * i;
-   }
-}
-
-void FftModifier::initScale(tFftModifiers& modifiers, int numOutputValues)
-{
-   // Map modifiers clip range to 0 to 0xFFFF
-   float rangeIn = modifiers.clipMax - modifiers.clipMin;
-   float rangeOut = (float)(0xFFFF);
-
-   float scalar = rangeOut / rangeIn;
-   m_offset = modifiers.clipMin;
-
-   // Compute the scalar value per output.
-   int stopAttenOutIndex = 0;
-   m_scalar.resize(numOutputValues);
-   if(modifiers.attenLowFreqs)
-   {
-      // Determine which Output Index to stop attenuating at.
-      int stopFftBin = modifiers.attenLowStopFreq / m_hzPerBin;
-      while(m_indexMap[stopAttenOutIndex] < stopFftBin)
-      {
-         stopAttenOutIndex++;
-      }
-
-      // Attenuate linearly across the output values.
-      float minY = modifiers.attenLowStartLevel;
-      float deltaY = 1.0 - minY;
-      float maxX = (float)stopAttenOutIndex;
-
-      for(int i = 0; i < stopAttenOutIndex; ++i)
-      {
-         float attenZeroToOne = atten_quarterCircle((float)i / maxX);
-         float attenScalar = minY + attenZeroToOne * deltaY;
-         m_scalar[i] = attenScalar * scalar * 32768.0; // Q15
-      }
-   }
-   // Fill in the non-attenuating output values.
-   for(int i = stopAttenOutIndex; i < numOutputValues; ++i)
-   {
-      m_scalar[i] = scalar * 32768.0; // Q15
-   }
-
-}
-
-float FftModifier::atten_linear(float zeroToOne)
-{
-   return zeroToOne;
-}
-
-float FftModifier::atten_quarterCircle(float zeroToOne)
-{
-   float oneToZero = 1.0f - zeroToOne;
-   return sqrtf(1.0f - oneToZero*oneToZero);
-}
-
+/* Copyright 2020 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <string.h> // memcpy
+#include <algorithm> // std::upper_bound
+#include <utility>
+#include "fftModifier.h"
+#include "fastMath.h"
+
+#define BAND_SLICE (4) // Output values computed together.
+
+typedef float v4sf __attribute__((vector_size(16)));
+typedef int32_t v4si __attribute__((vector_size(16)));
+
+
+FftModifier::FftModifier(float samplesRate, int fftSize, int numOutputValues, tFftModifiers& modifiers):
+   m_freqRange(samplesRate / 2.0),
+   m_hzPerBin(samplesRate/((float)fftSize)),
+   m_numBins(fftSize>>1),
+   m_logScale(modifiers.logScale),
+   m_attackSec(modifiers.attackMs / 1000.0f),
+   m_releaseSec(modifiers.releaseMs / 1000.0f),
+   m_envelope(numOutputValues, 0.0f),
+   m_lastResultTime(-1.0)
+{
+   initBands(numOutputValues, modifiers);
+   initScale(modifiers, numOutputValues);
+}
+
+FftModifier::FftModifier(const std::vector<float>& binFreqs, int numOutputValues, tFftModifiers& modifiers):
+   m_hzPerBin(binFreqs[1] - binFreqs[0]),
+   m_binFreqs(binFreqs),
+   m_numBins(binFreqs.size()),
+   m_logScale(modifiers.logScale),
+   m_attackSec(modifiers.attackMs / 1000.0f),
+   m_releaseSec(modifiers.releaseMs / 1000.0f),
+   m_envelope(numOutputValues, 0.0f),
+   m_lastResultTime(-1.0)
+{
+   // The last bin goes up to Nyquist.
+   auto numBins = binFreqs.size();
+   m_freqRange = 2.0*binFreqs[numBins-1] - binFreqs[numBins-2];
+
+   initBands(numOutputValues, modifiers);
+   initScale(modifiers, numOutputValues);
+}
+
+FftModifier::~FftModifier()
+{
+
+}
+
+int FftModifier::modify(uint16_t* inOut, double resultTime)
+{
+   applyBands(inOut); // All the inputs are read before any outputs are written.
+
+   int numOuts = m_numOutputs;
+   for(int outIndex = 0; outIndex < numOuts; ++outIndex)
+   {
+      int32_t sum = m_bandOut[outIndex] + 0.5f;
+      sum = ((sum - m_offset) * m_scalar[outIndex]) >> 15;
+      
+      if(sum > 0xFFFF) sum = 0xFFFF;
+      else if(sum < 0) sum = 0;
+      inOut[outIndex] = sum;
+   }
+   if(m_logScale)
+      logScale(inOut, numOuts);
+
+   if(m_attackSec > 0.0f || m_releaseSec > 0.0f)
+      envelope(inOut, numOuts, resultTime);
+
+   return numOuts;
+}
+
+int FftModifier::modifyPower(const float* inPower, uint16_t* out, double resultTime)
+{
+   static constexpr float maxLog = 11.0903389f; // log(0xFFFF)
+
+   // When there is no offset, log(scalar * sqrt(power)) = log(scalar) + 0.5*log(power), so no square root is needed at all.
+   bool logInPowerDomain = m_logScale && m_offset == 0;
+
+   int numOuts = m_numOutputs;
+   if(logInPowerDomain)
+   {
+      applyBands(inPower);
+      FastMath::log(m_bandOut.data(), m_bandOut.data(), numOuts);
+   }
+   else
+   {
+      // Sum the magnitudes, not the power, so the outputs are at the same level as modify (the
+      // square root of the mean power reads brighter for bands that cover more than one bin).
+      int numUsedBins = m_stopUsedBin - m_firstUsedBin;
+      if(numUsedBins > 0)
+         FastMath::sqrt(&inPower[m_firstUsedBin], &m_binMag[m_firstUsedBin], numUsedBins);
+      applyBands(m_binMag.data());
+   }
+
+   for(int outIndex = 0; outIndex < numOuts; ++outIndex)
+   {
+      if(logInPowerDomain)
+      {
+         float logVal = 0.5f * m_bandOut[outIndex] + m_logScalar[outIndex]; // m_bandOut is already log(power)
+         if(logVal > maxLog) logVal = maxLog;
+         else if(!(logVal > 0)) logVal = 0; // Also catches log(0), which is a very small number
+         out[outIndex] = logToOutput(logVal);
+      }
+      else
+      {
+         int32_t mag = m_bandOut[outIndex] + 0.5f;
+         mag = ((mag - m_offset) * m_scalar[outIndex]) >> 15;
+
+         if(mag > 0xFFFF) mag = 0xFFFF;
+         else if(mag < 0) mag = 0;
+         out[outIndex] = mag;
+      }
+   }
+   if(m_logScale && !logInPowerDomain)
+      logScale(out, numOuts);
+
+   if(m_attackSec > 0.0f || m_releaseSec > 0.0f)
+      envelope(out, numOuts, resultTime);
+
+   return numOuts;
+}
+
+void FftModifier::envelope(uint16_t* inOut, int num, double resultTime)
+{
+   // Turn the time constants into multipliers for however much time has passed since the last
+   // spectrum (i.e. one or more FFT hops).
+   float elapsed = m_lastResultTime < 0.0 ? 1e9f : (float)(resultTime - m_lastResultTime);
+   m_lastResultTime = resultTime;
+   float attackCoef = envelopeCoef(elapsed, m_attackSec);
+   float releaseCoef = envelopeCoef(elapsed, m_releaseSec);
+
+   // env = in + coef * (env - in), where coef is the attack or release multiplier. No branches.
+   const v4sf attack = {attackCoef, attackCoef, attackCoef, attackCoef};
+   const v4sf release = {releaseCoef, releaseCoef, releaseCoef, releaseCoef};
+   float* env = m_envelope.data();
+   int i = 0;
+   for(; i + 4 <= num; i += 4)
+   {
+      v4sf in = {(float)inOut[i], (float)inOut[i+1], (float)inOut[i+2], (float)inOut[i+3]};
+      v4sf prev;
+      memcpy(&prev, &env[i], sizeof(prev));
+      v4si rising = in > prev;
+      v4sf coef = (v4sf)(((v4si)attack & rising) | ((v4si)release & ~rising));
+      v4sf next = in + coef * (prev - in);
+      memcpy(&env[i], &next, sizeof(next));
+      for(int lane = 0; lane < 4; ++lane)
+         inOut[i+lane] = (uint16_t)(next[lane] + 0.5f);
+   }
+   for(; i < num; ++i)
+   {
+      float in = inOut[i];
+      float coef = in > env[i] ? attackCoef : releaseCoef;
+      env[i] = in + coef * (env[i] - in);
+      inOut[i] = (uint16_t)(env[i] + 0.5f);
+   }
+}
+
+float FftModifier::envelopeCoef(float elapsedSec, float timeConstSec)
+{
+   static constexpr float log2e = 1.44269504f;
+   if(!(timeConstSec > 0.0f))
+      return 0.0f;
+   return FastMath::exp2(-elapsedSec / timeConstSec * log2e); // exp(-elapsed / timeConst)
+}
+
+void FftModifier::logScale(uint16_t* inOut, int num)
+{
+   for(int i = 0; i < num; ++i)
+   {
+      if(inOut[i] == 0) inOut[i] = 1; // Log of 0 is invalid, set to 1 to avoid.
+
+      inOut[i] = logToOutput(FastMath::log((float)inOut[i]));
+   }
+}
+
+uint16_t FftModifier::logToOutput(float logValue)
+{
+   static constexpr float maxU16 = (float)0xFFFF;
+   static constexpr float scalar = maxU16 / 4.8165; // log(0xFFFF) ~= 4.8165 (make sure to round up so scaler is slightly smaller)
+   float outVal = logValue * scalar;
+   return outVal > maxU16 ? 0xFFFF : (uint16_t)outVal;
+}
+
+float FftModifier::spliceToFreq(float splice, float range, bool isStop)
+{
+   float value = isStop ? range + splice : splice;
+   while(value < 0) value += range;
+   while(value > range) value -= range;
+   return value;
+}
+
+float FftModifier::freqToBin(float freq)
+{
+   if(m_binFreqs.empty())
+      return freq / m_hzPerBin;
+
+   // Find the bin at or below 'freq' and interpolate to the next bin.
+   int numBins = m_binFreqs.size();
+   int bin = std::upper_bound(m_binFreqs.begin(), m_binFreqs.end(), freq) - m_binFreqs.begin() - 1;
+   bin = std::max(0, std::min(bin, numBins-2));
+   return bin + (freq - m_binFreqs[bin]) / (m_binFreqs[bin+1] - m_binFreqs[bin]);
+}
+
+void FftModifier::getBandFreqs(int outIndex, tFftModifiers& modifiers, float startFreq, float stopFreq, float& bandStart, float& bandStop)
+{
+   float startPos = (float)outIndex / (float)m_numOutputs;
+   float stopPos = (float)(outIndex+1) / (float)m_numOutputs;
+   switch(modifiers.bandSpacing)
+   {
+      default:
+      case E_BAND_SPACING_LINEAR:
+      {
+         bandStart = startFreq + (stopFreq-startFreq) * startPos;
+         bandStop  = startFreq + (stopFreq-startFreq) * stopPos;
+      }
+      break;
+      case E_BAND_SPACING_LOG:
+      {
+         float logStart = logf(std::max(startFreq, 1.0f));
+         float logStop = logf(std::max(stopFreq, 1.0f));
+         bandStart = expf(logStart + (logStop-logStart) * startPos);
+         bandStop  = expf(logStart + (logStop-logStart) * stopPos);
+      }
+      break;
+      case E_BAND_SPACING_MEL:
+      {
+         float melStart = 2595.0f * log10f(1.0f + startFreq / 700.0f);
+         float melStop = 2595.0f * log10f(1.0f + stopFreq / 700.0f);
+         bandStart = 700.0f * (powf(10.0f, (melStart + (melStop-melStart) * startPos) / 2595.0f) - 1.0f);
+         bandStop  = 700.0f * (powf(10.0f, (melStart + (melStop-melStart) * stopPos ) / 2595.0f) - 1.0f);
+      }
+      break;
+      case E_BAND_SPACING_OCTAVE:
+      {
+         // Spread the 1/N octave bands that cover startFreq to stopFreq across the outputs.
+         float bandsPerOctave = std::max(modifiers.bandsPerOctave, 1);
+         int firstBand = floorf(bandsPerOctave * log2f(std::max(startFreq, 1.0f) / 1000.0f));
+         int stopBand = ceilf(bandsPerOctave * log2f(std::max(stopFreq, 1.0f) / 1000.0f));
+         int numBands = std::max(stopBand - firstBand, 1);
+         int bandIndex = firstBand + (outIndex * numBands) / m_numOutputs;
+         int bandStopIndex = std::max(firstBand + ((outIndex+1) * numBands) / m_numOutputs, bandIndex+1);
+         bandStart = std::max(startFreq, 1000.0f * exp2f(bandIndex / bandsPerOctave));
+         bandStop  = std::min(stopFreq, 1000.0f * exp2f(bandStopIndex / bandsPerOctave));
+      }
+      break;
+   }
+}
+
+void FftModifier::initBands(int numOutputValues, tFftModifiers& modifiers)
+{
+   typedef std::vector<std::pair<int, float>> tTaps; // Bin, Weight
+
+   m_numOutputs = numOutputValues;
+
+   float startFreq = spliceToFreq(modifiers.startFreq, m_freqRange, false);
+   float stopFreq  = spliceToFreq(modifiers.stopFreq,  m_freqRange, true);
+
+   // Determine the bins / weights of each output value.
+   std::vector<tTaps> outTaps(numOutputValues);
+   m_bandStartBin.resize(numOutputValues);
+   m_firstUsedBin = m_numBins;
+   m_stopUsedBin = 0;
+   for(int outIndex = 0; outIndex < numOutputValues; ++outIndex)
+   {
+      float bandStart, bandStop;
+      getBandFreqs(outIndex, modifiers, startFreq, stopFreq, bandStart, bandStop);
+      float startBin = freqToBin(bandStart);
+      float stopBin = freqToBin(bandStop);
+      m_bandStartBin[outIndex] = startBin;
+
+      tTaps& taps = outTaps[outIndex];
+      if(stopBin - startBin < 1.0f)
+      {
+         // Narrower than a bin, interpolate between the 2 bins around the center of the band.
+         float center = std::max(0.5f * (startBin + stopBin), 0.0f);
+         int bin = std::min((int)center, m_numBins-1);
+         float frac = center - bin;
+         taps.push_back(std::make_pair(bin, 1.0f - frac));
+         if(frac > 0.0f && bin+1 < m_numBins)
+            taps.push_back(std::make_pair(bin+1, frac));
+      }
+      else
+      {
+         // Each bin covers +/- half a bin around its center, weight it by how much of it is in the band.
+         int firstBin = std::max((int)floorf(startBin + 0.5f), 0);
+         int lastBin = std::min((int)floorf(stopBin + 0.5f), m_numBins-1);
+         for(int bin = firstBin; bin <= lastBin; ++bin)
+         {
+            float overlap = std::min(stopBin, bin + 0.5f) - std::max(startBin, bin - 0.5f);
+            if(overlap > 0.0f)
+               taps.push_back(std::make_pair(bin, overlap));
+         }
+         if(taps.empty())
+            taps.push_back(std::make_pair(std::min(std::max((int)startBin, 0), m_numBins-1), 1.0f));
+      }
+
+      // Normalize so each output value is the weighted mean of its bins.
+      float sum = 0;
+      for(auto& tap : taps)
+         sum += tap.second;
+      for(auto& tap : taps)
+      {
+         tap.second /= sum;
+         m_firstUsedBin = std::min(m_firstUsedBin, tap.first);
+         m_stopUsedBin = std::max(m_stopUsedBin, tap.first+1);
+      }
+   }
+
+   // Pack into slices of BAND_SLICE outputs, padding the shorter ones with zero weights.
+   int numSlices = (numOutputValues + BAND_SLICE - 1) / BAND_SLICE;
+   m_sliceStart.assign(numSlices+1, 0);
+   for(int slice = 0; slice < numSlices; ++slice)
+   {
+      size_t maxTaps = 0;
+      for(int lane = 0; lane < BAND_SLICE; ++lane)
+      {
+         int outIndex = slice * BAND_SLICE + lane;
+         if(outIndex < numOutputValues)
+            maxTaps = std::max(maxTaps, outTaps[outIndex].size());
+      }
+      m_sliceStart[slice+1] = m_sliceStart[slice] + maxTaps;
+   }
+
+   m_bandBins.assign(m_sliceStart[numSlices] * BAND_SLICE, 0);
+   m_bandWeights.assign(m_sliceStart[numSlices] * BAND_SLICE, 0.0f);
+   for(int outIndex = 0; outIndex < numOutputValues; ++outIndex)
+   {
+      int slice = outIndex / BAND_SLICE;
+      int lane = outIndex % BAND_SLICE;
+      const tTaps& taps = outTaps[outIndex];
+      for(int tap = m_sliceStart[slice]; tap < m_sliceStart[slice+1]; ++tap)
+      {
+         size_t tapIndex = tap - m_sliceStart[slice];
+         bool padding = tapIndex >= taps.size();
+         m_bandBins[tap * BAND_SLICE + lane] = padding ? taps[0].first : taps[tapIndex].first;
+         m_bandWeights[tap * BAND_SLICE + lane] = padding ? 0.0f : taps[tapIndex].second;
+      }
+   }
+   m_bandOut.resize(numSlices * BAND_SLICE);
+   m_binMag.assign(m_numBins, 0.0f);
+}
+
+template<typename tIn>
+void FftModifier::applyBands(const tIn* in)
+{
+   // Gather 4 bins (one for each output in the slice), multiply by the weights and accumulate.
+   const int32_t* bins = m_bandBins.data();
+   const float* weights = m_bandWeights.data();
+   int numSlices = m_sliceStart.size() - 1;
+   for(int slice = 0; slice < numSlices; ++slice)
+   {
+      v4sf acc = {0.0f, 0.0f, 0.0f, 0.0f};
+      for(int tap = m_sliceStart[slice]; tap < m_sliceStart[slice+1]; ++tap)
+      {
+         const int32_t* tapBins = &bins[tap * BAND_SLICE];
+         v4sf x = {(float)in[tapBins[0]], (float)in[tapBins[1]], (float)in[tapBins[2]], (float)in[tapBins[3]]};
+         v4sf w;
+         memcpy(&w, &weights[tap * BAND_SLICE], sizeof(w));
+         acc += x * w;
+      }
+      memcpy(&m_bandOut[slice * BAND_SLICE], &acc, sizeof(acc));
+   }
+}
+
+void FftModifier::initScale(tFftModifiers& modifiers, int numOutputValues)
+{
+   // Map modifiers clip range to 0 to 0xFFFF
+   float rangeIn = modifiers.clipMax - modifiers.clipMin;
+   float rangeOut = (float)(0xFFFF);
+
+   float scalar = rangeOut / rangeIn;
+   m_offset = modifiers.clipMin;
+
+   // Compute the scalar value per output.
+   int stopAttenOutIndex = 0;
+   m_scalar.resize(numOutputValues);
+   if(modifiers.attenLowFreqs)
+   {
+      // Determine which Output Index to stop attenuating at.
+      int stopFftBin = freqToBin(modifiers.attenLowStopFreq);
+      while(stopAttenOutIndex < numOutputValues && m_bandStartBin[stopAttenOutIndex] < stopFftBin)
+      {
+         stopAttenOutIndex++;
+      }
+
+      // Attenuate linearly across the output values.
+      float minY = modifiers.attenLowStartLevel;
+      float deltaY = 1.0 - minY;
+      float maxX = (float)stopAttenOutIndex;
+
+      for(int i = 0; i < stopAttenOutIndex; ++i)
+      {
+         float attenZeroToOne = atten_quarterCircle((float)i / maxX);
+         float attenScalar = minY + attenZeroToOne * deltaY;
+         m_scalar[i] = attenScalar * scalar * 32768.0; // Q15
+      }
+   }
+   // Fill in the non-attenuating output values.
+   for(int i = stopAttenOutIndex; i < numOutputValues; ++i)
+   {
+      m_scalar[i] = scalar * 32768.0; // Q15
+   }
+
+   m_logScalar.resize(numOutputValues);
+   for(int i = 0; i < numOutputValues; ++i)
+   {
+      m_logScalar[i] = logf((float)m_scalar[i] / 32768.0f);
+   }
+
+}
+
+float FftModifier::atten_linear(float zeroToOne)
+{
+   return zeroToOne;
+}
+
+float FftModifier::atten_quarterCircle(float zeroToOne)
+{
+   float oneToZero = 1.0f - zeroToOne;
+   return sqrtf(1.0f - oneToZero*oneToZero);
+}
+
@@ -1,85 +1,129 @@
-/* Copyright 2020 Dan Williams. All Rights Reserved.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy of this
- * software and associated documentation files (the "Software"), to deal in the Software
- * without restriction, including without limitation the rights to use, copy, modify, merge,
- * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
- * to whom the Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all copies or
- * substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
- * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
- * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
- * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
- * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-#pragma once
-#include <stdint.h>
-#include <vector>
-
-typedef struct tFftModifiers
-{
-   float startFreq;
-   float stopFreq;
-
-   uint16_t clipMax;
-   uint16_t clipMin;
-
-   bool logScale;
-
-   bool attenLowFreqs;
-   float attenLowStartLevel;
-   float attenLowStopFreq;
-
-   int fadeAwayAmount;
-
-   // Constructor. Initialize to a Do Nothing state (i.e. do not modify the FFT)
-   tFftModifiers():startFreq(0.0), stopFreq(0.0), clipMax(0xFFFF), clipMin(0), logScale(false), attenLowFreqs(false), fadeAwayAmount(0){}
-}tFftModifiers;
-
-
-class FftModifier
-{
-public:
-   FftModifier(float samplesRate, int fftSize, int numOutputValues, tFftModifiers& modifiers);
-   virtual ~FftModifier();
-
-   int modify(uint16_t* inOut);
-
-private:
-   // Make uncopyable
-   FftModifier();
-   FftModifier(FftModifier const&);
-   void operator=(FftModifier const&);
-
-   float m_freqRange;
-   float m_hzPerBin;
-
-   std::vector<int> m_indexMap;
-
-   // Used to shift result back to 0 to 0xFFFF.
-   std::vector<int32_t> m_scalar;
-   int32_t m_offset;
-
-   bool m_logScale;
-
-   // Fade Away Parameters
-   std::vector<int32_t> m_fadeAwayPeak;
-   std::vector<int> m_fadeAwayCountDown;
-   int m_fadeAwayAmount;
-   
-   void fadeAway(uint16_t* inOut, int num);
-
-   float spliceToFreq(float splice, float range, bool isStop);
-   void initIndexMap(float samplesRate, int fftSize, int numOutputValues, tFftModifiers& modifiers);
-   void initScale(tFftModifiers& modifiers, int numOutputValues);
-
-   void logScale(uint16_t* inOut, int num);
-
-   float atten_quarterCircle(float zeroToOne);
-   float atten_linear(float zeroToOne);
-};
-
+/* Copyright 2020 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+// How the output values are spread from startFreq to stopFreq.
+typedef enum
+{
+   E_BAND_SPACING_LINEAR,
+   E_BAND_SPACING_LOG,
+   E_BAND_SPACING_MEL,
+   E_BAND_SPACING_OCTAVE // Standard 1/N octave bands (centered on 1 kHz), neighboring outputs can share a band.
+}eBandSpacing;
+
+typedef struct tFftModifiers
+{
+   float startFreq;
+   float stopFreq;
+
+   eBandSpacing bandSpacing;
+   int bandsPerOctave; // Only for E_BAND_SPACING_OCTAVE (e.g. 3 for 1/3 octave bands).
+
+   uint16_t clipMax;
+   uint16_t clipMin;
+
+   bool logScale;
+
+   bool attenLowFreqs;
+   float attenLowStartLevel;
+   float attenLowStopFreq;
+
+   // Attack / release envelope time constants (0 means follow the input instantly). These are
+   // in real time, so the look doesn't change with the FFT rate or the LED refresh rate.
+   float attackMs;
+   float releaseMs;
+
+   // Constructor. Initialize to a Do Nothing state (i.e. do not modify the FFT)
+   tFftModifiers():startFreq(0.0), stopFreq(0.0), bandSpacing(E_BAND_SPACING_LINEAR), bandsPerOctave(3), clipMax(0xFFFF), clipMin(0), logScale(false), attenLowFreqs(false), attackMs(0.0), releaseMs(0.0){}
+}tFftModifiers;
+
+
+class FftModifier
+{
+public:
+   FftModifier(float samplesRate, int fftSize, int numOutputValues, tFftModifiers& modifiers);
+   FftModifier(const std::vector<float>& binFreqs, int numOutputValues, tFftModifiers& modifiers); // Non-uniformly spaced bins (center frequency of each bin).
+   virtual ~FftModifier();
+
+   // 'resultTime' is the time (in seconds) of the spectrum, used for the attack / release envelope.
+   int modify(uint16_t* inOut, double resultTime);
+
+   // Same as modify, but the input is the FFT power spectrum (squared magnitudes). When log
+   // scaling, the bins are summed in the power domain, so no square roots are needed. Otherwise the
+   // used bins' magnitudes are summed (a batch square root), so the level matches modify.
+   int modifyPower(const float* inPower, uint16_t* out, double resultTime);
+
+   // The range of FFT bins that are actually used to generate the output.
+   void getUsedBins(int& firstBin, int& numBins){firstBin = m_firstUsedBin; numBins = m_stopUsedBin - m_firstUsedBin;}
+
+private:
+   // Make uncopyable
+   FftModifier();
+   FftModifier(FftModifier const&);
+   void operator=(FftModifier const&);
+
+   float m_freqRange;
+   float m_hzPerBin;
+   std::vector<float> m_binFreqs; // Empty when the bins are uniformly spaced by m_hzPerBin.
+   int m_numBins;
+
+   // Sparse band matrix (each output value is a weighted sum of FFT bins). The outputs are stored
+   // in slices of 4 (padded with zero weights) so 4 outputs are computed at once.
+   int m_numOutputs;
+   std::vector<int> m_sliceStart; // First tap of each slice (plus one past the end).
+   std::vector<int32_t> m_bandBins; // Bin index of each tap, 4 per tap (one per output in the slice).
+   std::vector<float> m_bandWeights; // Weight of each tap, 4 per tap.
+   std::vector<float> m_bandOut; // Weighted sum for each output value.
+   std::vector<float> m_binMag; // Magnitude of each FFT bin (only the used bins are filled in, see modifyPower).
+   std::vector<float> m_bandStartBin; // Fractional bin where each output value starts.
+   int m_firstUsedBin;
+   int m_stopUsedBin; // One past the last used bin.
+
+   // Used to shift result back to 0 to 0xFFFF.
+   std::vector<int32_t> m_scalar;
+   std::vector<float> m_logScalar; // log(m_scalar) (for log scaling in the power domain).
+   int32_t m_offset;
+
+   bool m_logScale;
+
+   // Attack / Release Envelope
+   float m_attackSec;
+   float m_releaseSec;
+   std::vector<float> m_envelope;
+   double m_lastResultTime;
+
+   void envelope(uint16_t* inOut, int num, double resultTime);
+   float envelopeCoef(float elapsedSec, float timeConstSec);
+
+   float spliceToFreq(float splice, float range, bool isStop);
+   float freqToBin(float freq);
+   void getBandFreqs(int outIndex, tFftModifiers& modifiers, float startFreq, float stopFreq, float& bandStart, float& bandStop);
+   void initBands(int numOutputValues, tFftModifiers& modifiers);
+   template<typename tIn> void applyBands(const tIn* in);
+   void initScale(tFftModifiers& modifiers, int numOutputValues);
+
+   void logScale(uint16_t* inOut, int num);
+   uint16_t logToOutput(float logValue);
+
+   float atten_quarterCircle(float zeroToOne);
+   float atten_linear(float zeroToOne);
+};
+
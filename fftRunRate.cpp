@@ -1,64 +1,133 @@
-/* Copyright 2020 Dan Williams. All Rights Reserved.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy of this
- * software and associated documentation files (the "Software"), to deal in the Software
- * without restriction, including without limitation the rights to use, copy, modify, merge,
- * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
- * to whom the Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all copies or
- * substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
- * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
- * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
- * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
- * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-#include <assert.h>
-#include <string.h> // memcpy
-#include <algorithm> // std::max
-#include "fftRunRate.h"
-
-
-FftRunRate::FftRunRate(float sampleRate, int fftSize, float fftRate):
-   m_sampRate(sampleRate),
-   m_fftSize(fftSize),
-   m_fft(fftSize)
-{
-   float newSampPerFft = sampleRate / fftRate;
-   assert(newSampPerFft >= fftSize); // Current implementation cannot handle the same sample being used in multiple FFTs.
-
-   m_numSampToRemoveAfterFft = (newSampPerFft + 0.5); // Round to nearest whole number.
-   m_numSampNeededToDoFft = std::max(m_numSampToRemoveAfterFft, fftSize);
-
-   m_pcmBuffer.reserve(sampleRate);
-   m_fftResult.resize(fftSize>>1);
-}
-
-FftRunRate::~FftRunRate()
-{
-
-}
-
-SpecAnLedTypes::tFftVector* FftRunRate::run(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp)
-{
-   SpecAnLedTypes::tFftVector* fftResults = nullptr;
-
-   // Copy new samples in.
-   auto origSize = m_pcmBuffer.size();
-   m_pcmBuffer.resize(origSize+numSamp);
-   memcpy(&m_pcmBuffer[origSize], samples, numSamp*sizeof(samples[0]));
-
-   // Run the FFT(s)
-   while(m_pcmBuffer.size() >= (size_t)m_numSampNeededToDoFft)
-   {
-      m_fft.runFft(m_pcmBuffer.data(), m_fftResult.data());
-      fftResults = &m_fftResult;
-      m_pcmBuffer.erase(m_pcmBuffer.begin(), m_pcmBuffer.begin()+m_numSampToRemoveAfterFft);
-   }
-
-   return fftResults;
-}
-
+/* Copyright 2020 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <string.h> // memcpy
+#include <algorithm> // std::min
+#include "fftRunRate.h"
+
+
+FftRunRate::FftRunRate(float sampleRate, int fftSize, float fftRate, eFftPolicy policy, WindowTables::eWindow window, FftBackend::eBackendType backendType):
+   m_sampRate(sampleRate),
+   m_fftSize(fftSize),
+   m_policy(policy),
+   m_fft(fftSize, window, backendType),
+   m_numSampWritten(0),
+   m_nextFftStart(0)
+{
+   // The hop size can be smaller than the FFT size (i.e. overlapping FFTs).
+   m_hopSize = (sampleRate / fftRate + 0.5); // Round to nearest whole number.
+   if(m_hopSize < 1)
+      m_hopSize = 1;
+
+   // Size the circular buffer to hold about a second of samples (at least 2 FFTs worth). The
+   // 'latest only' policy needs the buffer to hold at least one FFT plus one hop.
+   m_bufferCapacity = std::max((size_t)sampleRate, (size_t)(fftSize*2));
+   m_bufferCapacity = std::max(m_bufferCapacity, (size_t)(fftSize+m_hopSize));
+   m_pcmBuffer.resize(m_bufferCapacity*2);
+
+   m_fftResult.resize(fftSize>>1);
+   m_fftPowerResult.resize(fftSize>>1);
+   m_welchSum.resize(fftSize>>1);
+}
+
+FftRunRate::~FftRunRate()
+{
+
+}
+
+void FftRunRate::addSamples(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp)
+{
+   // Write to both halves of the mirrored buffer, so any FFT window can be read without wrapping.
+   while(numSamp > 0)
+   {
+      size_t writeIndex = m_numSampWritten % m_bufferCapacity;
+      size_t toCopy = std::min(numSamp, m_bufferCapacity - writeIndex);
+      memcpy(&m_pcmBuffer[writeIndex], samples, toCopy*sizeof(samples[0]));
+      memcpy(&m_pcmBuffer[writeIndex+m_bufferCapacity], samples, toCopy*sizeof(samples[0]));
+
+      samples += toCopy;
+      numSamp -= toCopy;
+      m_numSampWritten += toCopy;
+   }
+}
+
+template<typename tFftOut>
+bool FftRunRate::runFfts(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp, void (SpecAnFft::*fftFunc)(int16_t*, tFftOut*), tFftOut* result)
+{
+   if(m_policy == E_FFT_POLICY_LATEST_ONLY)
+   {
+      // Only the newest FFT window is needed, so skip straight to it.
+      addSamples(samples, numSamp);
+      if(m_numSampWritten < m_nextFftStart + m_fftSize)
+         return false;
+
+      uint64_t numHopsToSkip = (m_numSampWritten - m_fftSize - m_nextFftStart) / m_hopSize;
+      m_nextFftStart += numHopsToSkip * m_hopSize;
+      (m_fft.*fftFunc)(&m_pcmBuffer[m_nextFftStart % m_bufferCapacity], result);
+      m_nextFftStart += m_hopSize;
+      return true;
+   }
+
+   // Welch averaging, every FFT window contributes to the result.
+   int numFfts = 0;
+   const size_t numBins = m_welchSum.size();
+   std::fill(m_welchSum.begin(), m_welchSum.end(), 0.0f);
+
+   // Don't write more than (capacity - fftSize) samples before running the FFTs that are ready,
+   // otherwise the start of the oldest pending FFT window could be overwritten.
+   const size_t maxWriteSize = m_bufferCapacity - m_fftSize;
+   do
+   {
+      size_t toWrite = std::min(numSamp, maxWriteSize);
+      addSamples(samples, toWrite);
+      samples += toWrite;
+      numSamp -= toWrite;
+
+      // Run the FFT(s)
+      while(m_numSampWritten >= m_nextFftStart + m_fftSize)
+      {
+         (m_fft.*fftFunc)(&m_pcmBuffer[m_nextFftStart % m_bufferCapacity], result);
+         for(size_t i = 0; i < numBins; ++i)
+            m_welchSum[i] += result[i];
+         m_nextFftStart += m_hopSize;
+         ++numFfts;
+      }
+   } while(numSamp > 0);
+
+   if(numFfts > 1)
+   {
+      float scalar = 1.0f / numFfts;
+      for(size_t i = 0; i < numBins; ++i)
+         result[i] = m_welchSum[i] * scalar;
+   }
+
+   return numFfts > 0;
+}
+
+SpecAnLedTypes::tFftVector* FftRunRate::run(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp)
+{
+   bool fftRan = runFfts(samples, numSamp, &SpecAnFft::runFft, m_fftResult.data());
+   return fftRan ? &m_fftResult : nullptr;
+}
+
+SpecAnLedTypes::tFftPowerVector* FftRunRate::runPower(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp)
+{
+   bool fftRan = runFfts(samples, numSamp, &SpecAnFft::runFftPower, m_fftPowerResult.data());
+   return fftRan ? &m_fftPowerResult : nullptr;
+}
+
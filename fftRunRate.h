@@ -1,53 +1,79 @@
-/* Copyright 2020 Dan Williams. All Rights Reserved.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy of this
- * software and associated documentation files (the "Software"), to deal in the Software
- * without restriction, including without limitation the rights to use, copy, modify, merge,
- * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
- * to whom the Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all copies or
- * substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
- * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
- * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
- * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
- * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-#pragma once
-
-#include "specAnLedPiTypes.h"
-#include "specAnFft.h"
-
-
-class FftRunRate
-{
-public:
-   FftRunRate(float sampleRate, int fftSize, float fftRate);
-   virtual ~FftRunRate();
-
-   SpecAnLedTypes::tFftVector* run(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp);
-
-
-private:
-   // Make uncopyable
-   FftRunRate();
-   FftRunRate(FftRunRate const&);
-   void operator=(FftRunRate const&);
-
-
-   float m_sampRate;
-   int m_fftSize;
-
-   SpecAnFft m_fft;
-
-   SpecAnLedTypes::tPcmBuffer m_pcmBuffer;
-   SpecAnLedTypes::tFftVector m_fftResult;
-
-   int m_numSampNeededToDoFft;
-   int m_numSampToRemoveAfterFft;
-
-};
-
+/* Copyright 2020 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "specAnLedPiTypes.h"
+#include "specAnFft.h"
+
+
+class FftRunRate
+{
+public:
+   // How to handle multiple FFT windows becoming ready in a single call to run / runPower.
+   typedef enum
+   {
+      E_FFT_POLICY_LATEST_ONLY,  // Only run the FFT on the newest window, skip the rest.
+      E_FFT_POLICY_WELCH_AVERAGE // Run all the FFTs and average them together.
+   }eFftPolicy;
+
+   FftRunRate(float sampleRate, int fftSize, float fftRate, eFftPolicy policy = E_FFT_POLICY_LATEST_ONLY, WindowTables::eWindow window = WindowTables::E_WINDOW_BLACKMAN_HARRIS, FftBackend::eBackendType backendType = FftBackend::E_BACKEND_FASTEST);
+   virtual ~FftRunRate();
+
+   SpecAnLedTypes::tFftVector* run(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp);
+   SpecAnLedTypes::tFftPowerVector* runPower(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp); // Same as run, but outputs the power spectrum.
+
+   // runPower only needs to fill in these bins (see SpecAnFft::planUsedBins).
+   void planUsedBins(int firstBin, int numBins){m_fft.planUsedBins(firstBin, numBins);}
+   void applyUsedBins(){m_fft.applyUsedBins();}
+
+   // Drop the buffered samples, the next FFT only uses samples added after this.
+   void flush(){m_nextFftStart = m_numSampWritten;}
+
+
+private:
+   // Make uncopyable
+   FftRunRate();
+   FftRunRate(FftRunRate const&);
+   void operator=(FftRunRate const&);
+
+
+   float m_sampRate;
+   int m_fftSize;
+   eFftPolicy m_policy;
+
+   SpecAnFft m_fft;
+
+   // Mirrored circular buffer (each sample is stored at 'index' and 'index + m_bufferCapacity').
+   SpecAnLedTypes::tPcmBuffer m_pcmBuffer;
+   size_t m_bufferCapacity;
+   SpecAnLedTypes::tFftVector m_fftResult;
+   SpecAnLedTypes::tFftPowerVector m_fftPowerResult;
+   std::vector<float> m_welchSum;
+
+   uint64_t m_numSampWritten; // Total number of samples written to the circular buffer.
+   uint64_t m_nextFftStart;   // Sample count of the first sample of the next FFT.
+   int m_hopSize;             // Number of samples between the start of each FFT.
+
+   void addSamples(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp);
+
+   template<typename tFftOut>
+   bool runFfts(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp, void (SpecAnFft::*fftFunc)(int16_t*, tFftOut*), tFftOut* result);
+
+};
+
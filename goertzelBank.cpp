@@ -0,0 +1,96 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <string.h> // memcpy
+#include "goertzelBank.h"
+
+// GCC vector extensions compile to NEON / SSE when available and plain C otherwise.
+typedef float v4sf __attribute__((vector_size(16)));
+
+GoertzelBank::GoertzelBank(int numTaps, int firstBin, int numBins, const std::vector<int16_t>& windowQ15):
+   m_numTaps(numTaps),
+   m_firstBin(firstBin),
+   m_numBins(numBins),
+   m_window(numTaps, 1.0f),
+   m_windowedInput(numTaps)
+{
+   if(windowQ15.size() == (size_t)numTaps)
+   {
+      for(int i = 0; i < numTaps; ++i)
+      {
+         m_window[i] = (float)windowQ15[i] / 32768.0f;
+      }
+   }
+
+   int paddedBins = (numBins + BINS_PER_PASS - 1) / BINS_PER_PASS * BINS_PER_PASS;
+   m_coefs.resize(paddedBins, 0.0f);
+   m_power.resize(paddedBins);
+   for(int i = 0; i < numBins; ++i)
+   {
+      m_coefs[i] = 2.0 * cos(2.0 * M_PI * (double)(firstBin + i) / (double)numTaps);
+   }
+}
+
+GoertzelBank::~GoertzelBank()
+{
+
+}
+
+void GoertzelBank::runPower(const int16_t* inSamp, float* outPower)
+{
+   const float* x = m_windowedInput.data();
+   for(int i = 0; i < m_numTaps; ++i)
+   {
+      m_windowedInput[i] = (float)inSamp[i] * m_window[i];
+   }
+
+   // Scale to match the 1/N scaled FFT output.
+   const float scale = 1.0f / ((float)m_numTaps * (float)m_numTaps);
+
+   int numPadded = m_coefs.size();
+   for(int bin = 0; bin < numPadded; bin += BINS_PER_PASS)
+   {
+      // Two independent sets of 4 bins to hide the latency of the recursion.
+      v4sf coefA, coefB;
+      memcpy(&coefA, &m_coefs[bin  ], sizeof(coefA));
+      memcpy(&coefB, &m_coefs[bin+4], sizeof(coefB));
+
+      v4sf a1 = {0,0,0,0}, a2 = {0,0,0,0};
+      v4sf b1 = {0,0,0,0}, b2 = {0,0,0,0};
+      for(int n = 0; n < m_numTaps; ++n)
+      {
+         v4sf xn = {x[n], x[n], x[n], x[n]};
+         v4sf a0 = xn + coefA*a1 - a2;
+         v4sf b0 = xn + coefB*b1 - b2;
+         a2 = a1; a1 = a0;
+         b2 = b1; b1 = b0;
+      }
+
+      v4sf powA = (a1*a1 + a2*a2 - coefA*a1*a2);
+      v4sf powB = (b1*b1 + b2*b2 - coefB*b1*b2);
+      memcpy(&m_power[bin  ], &powA, sizeof(powA));
+      memcpy(&m_power[bin+4], &powB, sizeof(powB));
+   }
+
+   for(int i = 0; i < m_numBins; ++i)
+   {
+      outPower[m_firstBin+i] = m_power[i] * scale;
+   }
+}
+
@@ -0,0 +1,54 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+// Computes the power of a contiguous range of FFT bins with the Goertzel algorithm.
+// Cost is O(numTaps) per bin (vs O(numTaps * log(numTaps)) for the full FFT), so this
+// is cheaper than an FFT when only a handful of bins are needed. The output units
+// match FftBackend::runFftPower.
+class GoertzelBank
+{
+public:
+   GoertzelBank(int numTaps, int firstBin, int numBins, const std::vector<int16_t>& windowQ15);
+   virtual ~GoertzelBank();
+
+   // Only writes outPower[firstBin] to outPower[firstBin+numBins-1].
+   void runPower(const int16_t* inSamp, float* outPower);
+
+private:
+   // Make uncopyable
+   GoertzelBank();
+   GoertzelBank(GoertzelBank const&);
+   void operator=(GoertzelBank const&);
+
+   static constexpr int BINS_PER_PASS = 8; // Bins computed in parallel (SIMD lanes).
+
+   int m_numTaps;
+   int m_firstBin;
+   int m_numBins;
+
+   std::vector<float> m_window;
+   std::vector<float> m_windowedInput;
+   std::vector<float> m_coefs;  // 2*cos(2*pi*k/N), padded to a multiple of BINS_PER_PASS
+   std::vector<float> m_power;  // Padded output.
+};
+
@@ -0,0 +1,80 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include "ledMap.h"
+
+constexpr uint32_t LedMap::NO_LED;
+
+LedMap::LedMap(size_t numPhysicalLeds, const std::vector<tSegment>& segments):
+   m_map(numPhysicalLeds, NO_LED)
+{
+   for(auto& segment : segments)
+   {
+      size_t numLeds = segment.numLeds;
+      for(size_t i = 0; i < numLeds; ++i)
+      {
+         size_t led = i;
+         if(segment.serpentineWidth > 0)
+         {
+            size_t width = segment.serpentineWidth;
+            size_t row = led / width;
+            size_t col = led % width;
+            if(row & 1)
+               col = std::min(width, numLeds - row * width) - 1 - col; // The last row may be short.
+            led = row * width + col;
+         }
+         led = (led + segment.rotate) % numLeds;
+         if(segment.reverse)
+            led = numLeds - 1 - led;
+
+         size_t physical = segment.start + led;
+         if(physical < numPhysicalLeds)
+            m_map[physical] = m_numInputs + i;
+      }
+      m_numInputs += numLeds;
+   }
+}
+
+LedMap::LedMap(size_t numForward, size_t numReflection, bool separateReflection):
+   m_map(numReflection + numForward),
+   m_numInputs(separateReflection ? 2 * numForward : numForward)
+{
+   size_t reflectionStart = separateReflection ? numForward : 0;
+   for(size_t i = 0; i < numReflection; ++i)
+      m_map[i] = reflectionStart + numForward - 1 - i;
+   for(size_t i = 0; i < numForward; ++i)
+      m_map[numReflection + i] = i;
+}
+
+void LedMap::apply(const SpecAnLedTypes::tRgbColor* in, size_t numIn, SpecAnLedTypes::tRgbColor* out)
+{
+   // NO_LED is always past the end of the inputs.
+   size_t numOut = m_map.size();
+   const uint32_t* map = m_map.data();
+   for(size_t i = 0; i < numOut; ++i)
+      out[i].u32 = map[i] < numIn ? in[map[i]].u32 : SpecAnLedTypes::COLOR_BLACK;
+}
+
+void LedMap::apply(const SpecAnLedTypes::tRgbColor* in, size_t numIn, uint32_t* out)
+{
+   size_t numOut = m_map.size();
+   const uint32_t* map = m_map.data();
+   for(size_t i = 0; i < numOut; ++i)
+      out[i] = map[i] < numIn ? in[map[i]].u32 : SpecAnLedTypes::COLOR_BLACK;
+}
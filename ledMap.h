@@ -0,0 +1,66 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "specAnLedPiTypes.h"
+
+// Maps each output LED to an input LED, i.e. a precomputed gather. Any layout (reversed, rings,
+// serpentine matrices, multiple segments, mirroring) is then a single indexed copy.
+class LedMap
+{
+public:
+   // One physically contiguous run of LEDs.
+   typedef struct
+   {
+      size_t start;           // First physical LED of the segment.
+      size_t numLeds;
+      bool reverse;           // Wired in the opposite direction.
+      size_t rotate;          // Rings: the LED (counting from 'start') that the segment's first logical LED is on.
+      size_t serpentineWidth; // Matrices: > 0 means rows of this many LEDs, every other row wired in the opposite direction.
+   }tSegment;
+
+   static constexpr uint32_t NO_LED = 0xFFFFFFFF; // The output LED is always black.
+
+   // Physical layout. The logical LEDs are the segments, in order. Physical LEDs that aren't in a segment are black.
+   LedMap(size_t numPhysicalLeds, const std::vector<tSegment>& segments);
+
+   // Mirror. The last 'numForward' outputs are the inputs, the first 'numReflection' outputs are the
+   // reverse of the forward inputs or, if 'separateReflection', the reverse of the next 'numForward'
+   // inputs (e.g. the right channel of a stereo display).
+   LedMap(size_t numForward, size_t numReflection, bool separateReflection);
+
+   size_t getNumInputs(){return m_numInputs;}
+   size_t getNumOutputs(){return m_map.size();}
+
+   // 'out' must have room for getNumOutputs() LEDs. Inputs past 'numIn' are black.
+   void apply(const SpecAnLedTypes::tRgbColor* in, size_t numIn, SpecAnLedTypes::tRgbColor* out);
+   void apply(const SpecAnLedTypes::tRgbColor* in, size_t numIn, uint32_t* out);
+
+private:
+   // Make uncopyable
+   LedMap();
+   LedMap(LedMap const&);
+   void operator=(LedMap const&);
+
+   std::vector<uint32_t> m_map; // Input index of each output LED.
+   size_t m_numInputs = 0;
+};
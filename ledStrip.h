@@ -1,56 +1,65 @@
-/* Copyright 2020 Dan Williams. All Rights Reserved.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy of this
- * software and associated documentation files (the "Software"), to deal in the Software
- * without restriction, including without limitation the rights to use, copy, modify, merge,
- * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
- * to whom the Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all copies or
- * substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
- * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
- * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
- * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
- * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-#pragma once
-
-#include <stddef.h>
-#include <stdint.h>
-#include "ws2811.h"
-#include "specAnLedPiTypes.h"
-
-class LedStrip
-{
-public:
-   typedef enum
-   {
-      RGB,
-      RBG,
-      GRB,
-      GBR,
-      BRG,
-      BGR
-   }eRgbOrder;
-
-   LedStrip(size_t numLeds, eRgbOrder order, unsigned gpio = 18);
-   virtual ~LedStrip();
-
-   void set(const SpecAnLedTypes::tRgbVector& ledColors);
-   void clear();
-   size_t getNumLeds() {return m_numLeds;}
-
-private:
-   // Make uncopyable
-   LedStrip();
-   LedStrip(LedStrip const&);
-   void operator=(LedStrip const&);
-
-   const size_t m_numLeds;
-   ws2811_t m_ledStrip;
-};
-
-
+/* Copyright 2020 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include "ws2811.h"
+#include "specAnLedPiTypes.h"
+#include "ledMap.h"
+
+class LedStrip
+{
+public:
+   typedef enum
+   {
+      RGB,
+      RBG,
+      GRB,
+      GBR,
+      BRG,
+      BGR
+   }eRgbOrder;
+
+   static constexpr unsigned DEFAULT_GPIO = 18;
+
+   // 'numLeds' is the number of physical LEDs. 'layout' maps the logical LEDs (what is passed to 'set')
+   // to the physical LEDs, empty means they are the same.
+   LedStrip(size_t numLeds, eRgbOrder order, unsigned gpio = DEFAULT_GPIO, const std::vector<LedMap::tSegment>& layout = std::vector<LedMap::tSegment>());
+   virtual ~LedStrip();
+
+   void set(const SpecAnLedTypes::tRgbVector& ledColors);
+   void clear();
+   size_t getNumLeds() {return m_numLeds;} // Number of logical LEDs.
+
+private:
+   // Make uncopyable
+   LedStrip();
+   LedStrip(LedStrip const&);
+   void operator=(LedStrip const&);
+
+   const size_t m_numPhysicalLeds;
+   std::unique_ptr<LedMap> m_layout;
+   size_t m_numLeds;
+   ws2811_t m_ledStrip;
+};
+
+
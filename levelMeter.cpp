@@ -0,0 +1,130 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <algorithm>
+#include "levelMeter.h"
+#include "pcmChannels.h"
+#include "fastMath.h"
+
+#define CHUNK_SIZE (64) // Samples per chunk (the K-weighting runs on each chunk while it is still in the cache).
+#define MOMENTARY_SEC (0.4f)
+#define MIN_LUFS (-120.0f)
+
+LevelMeter::LevelMeter(float sampleRate, bool loudness):
+   m_sampleRate(sampleRate),
+   m_loudness(loudness)
+{
+   // K-weighting filters for any sample rate (the BS.1770 coefficients are only given for 48 kHz).
+   static const double pi = 3.14159265358979323846;
+
+   // Stage 1, high shelf (about +4 dB above 1.5 kHz).
+   double k = tan(pi * 1681.974450955533 / sampleRate);
+   double q = 0.7071752369554196;
+   double vh = pow(10.0, 3.999843853973347 / 20.0);
+   double vb = pow(vh, 0.4996667741545416);
+   double a0 = 1.0 + k / q + k * k;
+   m_shelf.b0 = (vh + vb * k / q + k * k) / a0;
+   m_shelf.b1 = 2.0 * (k * k - vh) / a0;
+   m_shelf.b2 = (vh - vb * k / q + k * k) / a0;
+   m_shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+   m_shelf.a2 = (1.0 - k / q + k * k) / a0;
+   m_shelf.z1 = m_shelf.z2 = 0.0f;
+
+   // Stage 2, high pass (about 38 Hz).
+   k = tan(pi * 38.13547087602444 / sampleRate);
+   q = 0.5003270373238773;
+   a0 = 1.0 + k / q + k * k;
+   m_highPass.b0 = 1.0f;
+   m_highPass.b1 = -2.0f;
+   m_highPass.b2 = 1.0f;
+   m_highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+   m_highPass.a2 = (1.0 - k / q + k * k) / a0;
+   m_highPass.z1 = m_highPass.z2 = 0.0f;
+}
+
+LevelMeter::~LevelMeter()
+{
+
+}
+
+void LevelMeter::process(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp, tLevels& levels)
+{
+   // One pass over the samples: the vectorized peak / sum of squares and then the K-weighting for each chunk.
+   int32_t peak = 0;
+   uint64_t sumSquares = 0;
+   double kSumSquares = 0.0;
+   for(size_t i = 0; i < numSamp; i += CHUNK_SIZE)
+   {
+      size_t num = std::min((size_t)CHUNK_SIZE, numSamp - i);
+      int32_t chunkPeak;
+      uint64_t chunkSumSquares;
+      PcmChannels::peakAndSumSquares(samples+i, num, chunkPeak, chunkSumSquares);
+      peak = std::max(peak, chunkPeak);
+      sumSquares += chunkSumSquares;
+      if(m_loudness)
+         kSumSquares += kWeightedSumSquares(samples+i, num);
+   }
+
+   levels.peak = peak;
+   levels.rms = numSamp > 0 ? sqrtf((float)sumSquares / (float)numSamp) / 32768.0f : 0.0f;
+
+   // Momentary loudness.
+   if(numSamp > 0)
+   {
+      float coef = 1.0f - expf(-((float)numSamp / m_sampleRate) / MOMENTARY_SEC);
+      m_momentaryMeanSquare += coef * ((float)(kSumSquares / numSamp) - m_momentaryMeanSquare);
+   }
+   levels.loudness = sqrtf(m_momentaryMeanSquare);
+   static constexpr float powerToDb = 4.34294482f; // 10 / ln(10)
+   levels.loudnessLufs = m_momentaryMeanSquare > 0.0f ? -0.691f + powerToDb * FastMath::log(m_momentaryMeanSquare) : MIN_LUFS;
+   if(levels.loudnessLufs < MIN_LUFS)
+      levels.loudnessLufs = MIN_LUFS;
+}
+
+float LevelMeter::kWeightedSumSquares(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp)
+{
+   // The biquads are recursive, so this part is scalar (two biquads per sample).
+   static constexpr float toFloat = 1.0f / 32768.0f;
+   tBiquad s = m_shelf;
+   tBiquad h = m_highPass;
+   float sum = 0.0f;
+   for(size_t i = 0; i < numSamp; ++i)
+   {
+      float x = samples[i] * toFloat;
+      float y = s.b0 * x + s.z1;
+      s.z1 = s.b1 * x - s.a1 * y + s.z2;
+      s.z2 = s.b2 * x - s.a2 * y;
+
+      x = y;
+      y = h.b0 * x + h.z1;
+      h.z1 = h.b1 * x - h.a1 * y + h.z2;
+      h.z2 = h.b2 * x - h.a2 * y;
+      sum += y * y;
+   }
+
+   // Flush tiny values so silence doesn't leave denormals in the state.
+   static constexpr float tiny = 1e-20f;
+   if(fabsf(s.z1) < tiny) s.z1 = 0.0f;
+   if(fabsf(s.z2) < tiny) s.z2 = 0.0f;
+   if(fabsf(h.z1) < tiny) h.z1 = 0.0f;
+   if(fabsf(h.z2) < tiny) h.z2 = 0.0f;
+   m_shelf = s;
+   m_highPass = h;
+   return sum;
+}
@@ -0,0 +1,64 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "specAnLedPiTypes.h"
+
+// Peak, RMS and loudness of each frame of PCM, from a single pass over the samples. The loudness
+// is K-weighted (ITU-R BS.1770) and averaged over about 400 ms (the EBU momentary loudness), so it
+// is much steadier than the peak.
+class LevelMeter
+{
+public:
+   typedef struct
+   {
+      int32_t peak;       // Largest sample magnitude (0 to 32768).
+      float rms;          // 0 to 1 (full scale).
+      float loudness;     // K-weighted RMS (0 to 1), averaged over about 400 ms.
+      float loudnessLufs; // Same as 'loudness', in LUFS.
+   }tLevels;
+
+   // 'loudness' false skips the K-weighting (the loudness is then always 0), it costs more than the peak and RMS together.
+   LevelMeter(float sampleRate, bool loudness = true);
+   virtual ~LevelMeter();
+
+   void process(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp, tLevels& levels);
+
+private:
+   // Make uncopyable
+   LevelMeter();
+   LevelMeter(LevelMeter const&);
+   void operator=(LevelMeter const&);
+
+   typedef struct
+   {
+      float b0, b1, b2, a1, a2;
+      float z1, z2; // Transposed direct form II state.
+   }tBiquad;
+
+   float m_sampleRate;
+   bool m_loudness;
+   tBiquad m_shelf;    // K-weighting stage 1 (head effects).
+   tBiquad m_highPass; // K-weighting stage 2 (RLB weighting).
+   float m_momentaryMeanSquare = 0.0f;
+
+   float kWeightedSumSquares(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp);
+};
@@ -0,0 +1,110 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <string.h> // memcpy
+#include <algorithm> // std::min, std::max, std::fill
+#include "multiResAnalysis.h"
+
+// Only use the low band FFT up to this fraction of its Nyquist (the decimation filter rolls off above this).
+#define LOW_BAND_USABLE_FRACTION (0.6)
+
+
+MultiResAnalysis::MultiResAnalysis(float sampleRate, int fftSize, float fftRate, int lowBandDecimation, WindowTables::eWindow window, FftBackend::eBackendType backendType):
+   m_decimator(sampleRate, lowBandDecimation, LOW_BAND_USABLE_FRACTION * sampleRate / (2.0 * lowBandDecimation)),
+   m_lowBandFft(sampleRate / lowBandDecimation, fftSize, fftRate / 2.0, FftRunRate::E_FFT_POLICY_LATEST_ONLY, window, backendType), // Coarser time resolution anyway, run half as often.
+   m_fullBandFft(sampleRate, fftSize, fftRate, FftRunRate::E_FFT_POLICY_LATEST_ONLY, window, backendType)
+{
+   float lowHzPerBin = sampleRate / lowBandDecimation / fftSize;
+   float fullHzPerBin = sampleRate / fftSize;
+   float crossOverFreq = LOW_BAND_USABLE_FRACTION * sampleRate / (2.0 * lowBandDecimation);
+
+   m_numLowBandBins = ceilf(crossOverFreq / lowHzPerBin);
+   m_firstFullBandBin = ceilf(m_numLowBandBins * lowHzPerBin / fullHzPerBin);
+
+   int numFullBandBins = (fftSize >> 1) - m_firstFullBandBin;
+   m_binFreqs.resize(m_numLowBandBins + numFullBandBins);
+   for(int i = 0; i < m_numLowBandBins; ++i)
+      m_binFreqs[i] = i * lowHzPerBin;
+   for(int i = 0; i < numFullBandBins; ++i)
+      m_binFreqs[m_numLowBandBins+i] = (m_firstFullBandBin + i) * fullHzPerBin;
+
+   m_power.assign(m_binFreqs.size(), 0.0f);
+}
+
+const SpecAnLedTypes::tFftPowerVector* MultiResAnalysis::runPower(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp)
+{
+   bool newLowBand = false;
+   if(m_lowBandUsed)
+   {
+      m_decimatedSamples.resize(numSamp); // Plenty of room.
+      size_t numDecimated = m_decimator.decimate(samples, numSamp, m_decimatedSamples.data());
+      auto lowBandPower = m_lowBandFft.runPower(m_decimatedSamples.data(), numDecimated);
+      if(lowBandPower != nullptr)
+      {
+         m_lowBandPower = lowBandPower;
+         newLowBand = true;
+      }
+   }
+
+   auto fullBandPower = m_fullBandFft.runPower(samples, numSamp);
+   if(fullBandPower != nullptr)
+      m_fullBandPower = fullBandPower;
+
+   if(!newLowBand && fullBandPower == nullptr)
+      return nullptr;
+
+   // Merge the latest results from both FFTs.
+   if(m_lowBandPower != nullptr)
+      memcpy(m_power.data(), m_lowBandPower->data(), m_numLowBandBins*sizeof(m_power[0]));
+   if(m_fullBandPower != nullptr)
+      memcpy(&m_power[m_numLowBandBins], &(*m_fullBandPower)[m_firstFullBandBin], (m_power.size()-m_numLowBandBins)*sizeof(m_power[0]));
+   return &m_power;
+}
+
+void MultiResAnalysis::flush()
+{
+   m_decimator.flush();
+   m_lowBandFft.flush();
+   m_fullBandFft.flush();
+   m_lowBandPower = nullptr;
+   m_fullBandPower = nullptr;
+   std::fill(m_power.begin(), m_power.end(), 0.0f);
+}
+
+void MultiResAnalysis::planUsedBins(int firstBin, int numBins)
+{
+   int stopBin = firstBin + numBins;
+
+   // Low band part.
+   int lowStop = std::min(stopBin, m_numLowBandBins);
+   m_plannedLowBandUsed = firstBin < lowStop;
+   m_lowBandFft.planUsedBins(firstBin, lowStop - firstBin);
+
+   // Full band part (convert from merged spectrum bins to full band FFT bins).
+   int fullStart = std::max(firstBin, m_numLowBandBins) - m_numLowBandBins + m_firstFullBandBin;
+   int fullStop = stopBin - m_numLowBandBins + m_firstFullBandBin;
+   m_fullBandFft.planUsedBins(fullStart, fullStop - fullStart);
+}
+
+void MultiResAnalysis::applyUsedBins()
+{
+   m_lowBandUsed = m_plannedLowBandUsed;
+   m_lowBandFft.applyUsedBins();
+   m_fullBandFft.applyUsedBins();
+}
@@ -0,0 +1,68 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <vector>
+#include "specAnLedPiTypes.h"
+#include "decimator.h"
+#include "fftRunRate.h"
+
+// Multi-resolution spectrum. Runs a long (in time) FFT on a decimated copy of the signal for the
+// low frequencies and a short FFT on the full band for everything else. The two are merged into a
+// single power spectrum with non-uniformly spaced bins (see getBinFreqs).
+class MultiResAnalysis
+{
+public:
+   MultiResAnalysis(float sampleRate, int fftSize, float fftRate, int lowBandDecimation, WindowTables::eWindow window, FftBackend::eBackendType backendType);
+
+   // Returns nullptr if no new spectrum was computed.
+   const SpecAnLedTypes::tFftPowerVector* runPower(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp);
+
+   // Center frequency (Hz) of each bin in the merged spectrum.
+   const std::vector<float>& getBinFreqs(){return m_binFreqs;}
+
+   // Only bins 'firstBin' to 'firstBin+numBins-1' of the merged spectrum are used (plan and then
+   // apply, the same as SpecAnFft::planUsedBins / applyUsedBins).
+   void planUsedBins(int firstBin, int numBins);
+   void applyUsedBins();
+
+   // Drop the buffered samples and the previous results (see FftRunRate::flush).
+   void flush();
+
+private:
+   // Make uncopyable
+   MultiResAnalysis();
+   MultiResAnalysis(MultiResAnalysis const&);
+   void operator=(MultiResAnalysis const&);
+
+   Decimator m_decimator;
+   SpecAnLedTypes::tPcmBuffer m_decimatedSamples;
+
+   FftRunRate m_lowBandFft;
+   FftRunRate m_fullBandFft;
+   const SpecAnLedTypes::tFftPowerVector* m_lowBandPower = nullptr;
+   const SpecAnLedTypes::tFftPowerVector* m_fullBandPower = nullptr;
+   bool m_lowBandUsed = true;
+   bool m_plannedLowBandUsed = true;
+
+   int m_numLowBandBins;    // The first bins of the merged spectrum are from the low band FFT.
+   int m_firstFullBandBin;  // The rest are from the full band FFT, starting at this bin.
+
+   std::vector<float> m_binFreqs;
+   SpecAnLedTypes::tFftPowerVector m_power;
+};
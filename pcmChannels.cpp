@@ -0,0 +1,194 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include "pcmChannels.h"
+#include "cpuFeatures.h"
+
+#if defined(__ARM_NEON)
+#define PCM_NEON_KERNELS
+#include <arm_neon.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#define PCM_SSE_KERNELS
+#include <immintrin.h>
+#endif
+
+
+void PcmChannels::deinterleaveStereo_scalar(const int16_t* in, size_t numFrames, int16_t* left, int16_t* right, int16_t* mono)
+{
+   for(size_t i = 0; i < numFrames; ++i)
+   {
+      left[i] = in[2*i];
+      right[i] = in[2*i+1];
+      mono[i] = ((int32_t)left[i] + (int32_t)right[i]) >> 1;
+   }
+}
+
+#ifdef PCM_SSE_KERNELS
+__attribute__((target("sse2")))
+static void deinterleaveStereo_sse(const int16_t* in, size_t numFrames, int16_t* left, int16_t* right, int16_t* mono)
+{
+   const __m128i one = _mm_set1_epi16(1);
+   size_t i = 0;
+   for(; i + 8 <= numFrames; i += 8)
+   {
+      __m128i in0 = _mm_loadu_si128((const __m128i*)&in[2*i]);
+      __m128i in1 = _mm_loadu_si128((const __m128i*)&in[2*i+8]);
+
+      // Left is the low half of each 32 bit pair, right is the high half. Sign extend each to 32 bits, then pack back to 16 bits.
+      __m128i l = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(in0, 16), 16), _mm_srai_epi32(_mm_slli_epi32(in1, 16), 16));
+      __m128i r = _mm_packs_epi32(_mm_srai_epi32(in0, 16), _mm_srai_epi32(in1, 16));
+
+      // (l + r) >> 1 without overflow: (l >> 1) + (r >> 1) + (l & r & 1)
+      __m128i m = _mm_add_epi16(_mm_add_epi16(_mm_srai_epi16(l, 1), _mm_srai_epi16(r, 1)), _mm_and_si128(_mm_and_si128(l, r), one));
+
+      _mm_storeu_si128((__m128i*)&left[i], l);
+      _mm_storeu_si128((__m128i*)&right[i], r);
+      _mm_storeu_si128((__m128i*)&mono[i], m);
+   }
+   PcmChannels::deinterleaveStereo_scalar(in+2*i, numFrames-i, left+i, right+i, mono+i);
+}
+#endif
+
+#ifdef PCM_NEON_KERNELS
+static void deinterleaveStereo_neon(const int16_t* in, size_t numFrames, int16_t* left, int16_t* right, int16_t* mono)
+{
+   size_t i = 0;
+   for(; i + 8 <= numFrames; i += 8)
+   {
+      int16x8x2_t lr = vld2q_s16(&in[2*i]); // De-interleaving load.
+      vst1q_s16(&left[i], lr.val[0]);
+      vst1q_s16(&right[i], lr.val[1]);
+      vst1q_s16(&mono[i], vhaddq_s16(lr.val[0], lr.val[1]));
+   }
+   PcmChannels::deinterleaveStereo_scalar(in+2*i, numFrames-i, left+i, right+i, mono+i);
+}
+#endif
+
+void PcmChannels::deinterleaveStereo(const int16_t* in, size_t numFrames, int16_t* left, int16_t* right, int16_t* mono)
+{
+#if defined(PCM_NEON_KERNELS)
+   deinterleaveStereo_neon(in, numFrames, left, right, mono);
+#elif defined(PCM_SSE_KERNELS)
+   static const bool sse2 = CpuFeatures::hasSse2();
+   if(sse2)
+      deinterleaveStereo_sse(in, numFrames, left, right, mono);
+   else
+      deinterleaveStereo_scalar(in, numFrames, left, right, mono);
+#else
+   deinterleaveStereo_scalar(in, numFrames, left, right, mono);
+#endif
+}
+
+void PcmChannels::peakAndSumSquares_scalar(const int16_t* in, size_t numSamp, int32_t& peak, uint64_t& sumSquares)
+{
+   int32_t maxMag = 0;
+   uint64_t sum = 0;
+   for(size_t i = 0; i < numSamp; ++i)
+   {
+      int32_t samp = in[i];
+      int32_t mag = samp < 0 ? -samp : samp;
+      if(mag > maxMag)
+         maxMag = mag;
+      sum += (uint32_t)(samp * samp);
+   }
+   peak = maxMag;
+   sumSquares = sum;
+}
+
+#ifdef PCM_SSE_KERNELS
+__attribute__((target("sse2")))
+static void peakAndSumSquares_sse(const int16_t* in, size_t numSamp, int32_t& peak, uint64_t& sumSquares)
+{
+   const __m128i zero = _mm_setzero_si128();
+   __m128i maxVal = zero;
+   __m128i minVal = zero;
+   __m128i sum = zero; // 2 x 64 bit
+   size_t i = 0;
+   for(; i + 8 <= numSamp; i += 8)
+   {
+      __m128i x = _mm_loadu_si128((const __m128i*)&in[i]);
+      maxVal = _mm_max_epi16(maxVal, x);
+      minVal = _mm_min_epi16(minVal, x);
+
+      // Sums of pairs of squares. These can be 2^31 (two -32768 samples), so zero extend them (i.e. treat them as unsigned).
+      __m128i sq = _mm_madd_epi16(x, x);
+      sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(sq, zero));
+      sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(sq, zero));
+   }
+
+   int16_t maxs[8], mins[8];
+   uint64_t sums[2];
+   _mm_storeu_si128((__m128i*)maxs, maxVal);
+   _mm_storeu_si128((__m128i*)mins, minVal);
+   _mm_storeu_si128((__m128i*)sums, sum);
+
+   PcmChannels::peakAndSumSquares_scalar(in+i, numSamp-i, peak, sumSquares);
+   for(int lane = 0; lane < 8; ++lane)
+      peak = std::max(peak, std::max((int32_t)maxs[lane], -(int32_t)mins[lane]));
+   sumSquares += sums[0] + sums[1];
+}
+#endif
+
+#ifdef PCM_NEON_KERNELS
+static void peakAndSumSquares_neon(const int16_t* in, size_t numSamp, int32_t& peak, uint64_t& sumSquares)
+{
+   int16x8_t maxVal = vdupq_n_s16(0);
+   int16x8_t minVal = vdupq_n_s16(0);
+   uint64x2_t sum = vdupq_n_u64(0);
+   size_t i = 0;
+   for(; i + 8 <= numSamp; i += 8)
+   {
+      int16x8_t x = vld1q_s16(&in[i]);
+      maxVal = vmaxq_s16(maxVal, x);
+      minVal = vminq_s16(minVal, x);
+
+      // Widening squares (at most 2^30) are accumulated in pairs into the 64 bit sums.
+      int32x4_t sqLow = vmull_s16(vget_low_s16(x), vget_low_s16(x));
+      int32x4_t sqHigh = vmull_s16(vget_high_s16(x), vget_high_s16(x));
+      sum = vpadalq_u32(sum, vreinterpretq_u32_s32(sqLow));
+      sum = vpadalq_u32(sum, vreinterpretq_u32_s32(sqHigh));
+   }
+
+   int16_t maxs[8], mins[8];
+   uint64_t sums[2];
+   vst1q_s16(maxs, maxVal);
+   vst1q_s16(mins, minVal);
+   vst1q_u64(sums, sum);
+
+   PcmChannels::peakAndSumSquares_scalar(in+i, numSamp-i, peak, sumSquares);
+   for(int lane = 0; lane < 8; ++lane)
+      peak = std::max(peak, std::max((int32_t)maxs[lane], -(int32_t)mins[lane]));
+   sumSquares += sums[0] + sums[1];
+}
+#endif
+
+void PcmChannels::peakAndSumSquares(const int16_t* in, size_t numSamp, int32_t& peak, uint64_t& sumSquares)
+{
+#if defined(PCM_NEON_KERNELS)
+   peakAndSumSquares_neon(in, numSamp, peak, sumSquares);
+#elif defined(PCM_SSE_KERNELS)
+   static const bool sse2 = CpuFeatures::hasSse2();
+   if(sse2)
+      peakAndSumSquares_sse(in, numSamp, peak, sumSquares);
+   else
+      peakAndSumSquares_scalar(in, numSamp, peak, sumSquares);
+#else
+   peakAndSumSquares_scalar(in, numSamp, peak, sumSquares);
+#endif
+}
@@ -0,0 +1,36 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Vectorized helpers for multi channel PCM. NEON is used when the build targets NEON, SSE2 is
+// used on x86. Everything else gets the plain C version.
+namespace PcmChannels
+{
+   // Split interleaved stereo (L R L R ...) into separate left and right buffers. Also fills in
+   // the mono mix of the two, i.e. (left + right) / 2.
+   void deinterleaveStereo(const int16_t* in, size_t numFrames, int16_t* left, int16_t* right, int16_t* mono);
+   void deinterleaveStereo_scalar(const int16_t* in, size_t numFrames, int16_t* left, int16_t* right, int16_t* mono);
+
+   // Largest sample magnitude (0 to 32768) and the sum of the squared samples.
+   void peakAndSumSquares(const int16_t* in, size_t numSamp, int32_t& peak, uint64_t& sumSquares);
+   void peakAndSumSquares_scalar(const int16_t* in, size_t numSamp, int32_t& peak, uint64_t& sumSquares);
+}
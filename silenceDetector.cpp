@@ -0,0 +1,80 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include "silenceDetector.h"
+#include "fastMath.h"
+#include "pcmChannels.h"
+
+#define FLOOR_RISE_DB_PER_SEC (1.0f) // How fast the noise floor creeps up.
+#define FLOOR_FALL_TIME_SEC (0.02f)  // Time constant of the noise floor following quieter levels down.
+#define MIN_LEVEL_DB (-120.0f)
+
+SilenceDetector::SilenceDetector(float sampleRate, float idleTimeoutSec, float marginDb, float maxFloorDb):
+   m_sampleRate(sampleRate),
+   m_idleTimeoutSec(idleTimeoutSec),
+   m_marginDb(marginDb),
+   m_maxFloorDb(maxFloorDb),
+   m_noiseFloorDb(maxFloorDb)
+{
+
+}
+
+SilenceDetector::~SilenceDetector()
+{
+
+}
+
+bool SilenceDetector::process(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp)
+{
+   if(m_idleTimeoutSec <= 0.0f || numSamp == 0)
+      return false;
+
+   // Frame level, dB relative to full scale.
+   int32_t peak;
+   uint64_t sumSquares;
+   PcmChannels::peakAndSumSquares(samples, numSamp, peak, sumSquares);
+   float meanSquare = (float)sumSquares / ((float)numSamp * 32768.0f * 32768.0f);
+   static constexpr float powerToDb = 4.34294482f; // 10 / ln(10)
+   float levelDb = meanSquare > 0.0f ? powerToDb * FastMath::log(meanSquare) : MIN_LEVEL_DB;
+   if(levelDb < MIN_LEVEL_DB)
+      levelDb = MIN_LEVEL_DB;
+
+   // Update the noise floor.
+   float frameSec = (float)numSamp / m_sampleRate;
+   if(levelDb < m_noiseFloorDb)
+      m_noiseFloorDb += (levelDb - m_noiseFloorDb) * (1.0f - expf(-frameSec / FLOOR_FALL_TIME_SEC));
+   else
+      m_noiseFloorDb += FLOOR_RISE_DB_PER_SEC * frameSec;
+   if(m_noiseFloorDb > m_maxFloorDb)
+      m_noiseFloorDb = m_maxFloorDb;
+
+   // Idle once it has been quiet long enough, wake up as soon as it isn't.
+   if(levelDb < m_noiseFloorDb + m_marginDb)
+   {
+      m_quietTimeSec += frameSec;
+      if(m_quietTimeSec >= m_idleTimeoutSec)
+         m_idle = true;
+   }
+   else
+   {
+      m_quietTimeSec = 0.0f;
+      m_idle = false;
+   }
+   return m_idle;
+}
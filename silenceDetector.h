@@ -0,0 +1,55 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stddef.h>
+#include "specAnLedPiTypes.h"
+
+// Tracks the noise floor of the microphone and reports when the room has been quiet for a while,
+// so the FFTs / LED updates can be parked. A frame is quiet if it is within 'marginDb' of the
+// noise floor. The noise floor follows quiet levels down quickly and creeps up slowly, but never
+// above 'maxFloorDb' (so loud music is never mistaken for the noise floor).
+class SilenceDetector
+{
+public:
+   // 'idleTimeoutSec' <= 0 disables idle mode.
+   SilenceDetector(float sampleRate, float idleTimeoutSec, float marginDb = 10.0f, float maxFloorDb = -50.0f);
+   virtual ~SilenceDetector();
+
+   // Returns true while idle. Idle mode ends on the first frame that isn't quiet.
+   bool process(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp);
+
+   bool isIdle(){return m_idle;}
+   float getNoiseFloorDb(){return m_noiseFloorDb;}
+
+private:
+   // Make uncopyable
+   SilenceDetector();
+   SilenceDetector(SilenceDetector const&);
+   void operator=(SilenceDetector const&);
+
+   float m_sampleRate;
+   float m_idleTimeoutSec;
+   float m_marginDb;
+   float m_maxFloorDb;
+
+   float m_noiseFloorDb;
+   float m_quietTimeSec = 0.0f;
+   bool m_idle = false;
+};
@@ -1,47 +1,62 @@
-/* Copyright 2020 Dan Williams. All Rights Reserved.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy of this
- * software and associated documentation files (the "Software"), to deal in the Software
- * without restriction, including without limitation the rights to use, copy, modify, merge,
- * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
- * to whom the Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all copies or
- * substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
- * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
- * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
- * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
- * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-#pragma once
-
-#include <stdint.h>
-#include <vector>
-#include "NE10.h"
-
-class SpecAnFft
-{
-public:
-   SpecAnFft(int numTaps, bool window = true);
-   virtual ~SpecAnFft();
-
-   void runFft(int16_t* inSamp, uint16_t* outSamp);
-private:
-   // Make uncopyable
-   SpecAnFft();
-   SpecAnFft(SpecAnFft const&);
-   void operator=(SpecAnFft const&);
-
-   ne10_fft_r2c_cfg_int16_t m_ne10Config;
-   std::vector<ne10_fft_cpx_int16_t> m_tempComplex;
-
-   int m_numTaps;
-   bool m_window;
-   std::vector<int16_t> m_windowCoefs;
-   std::vector<int16_t> m_windowedInput;
-   void genWindowCoef(unsigned int numSamp, bool scale);
-};
-
+/* Copyright 2020 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <memory>
+#include "fftBackend.h"
+#include "goertzelBank.h"
+#include "windowTables.h"
+
+class SpecAnFft
+{
+public:
+   SpecAnFft(int numTaps, WindowTables::eWindow window = WindowTables::E_WINDOW_BLACKMAN_HARRIS, FftBackend::eBackendType backendType = FftBackend::E_BACKEND_FASTEST);
+   virtual ~SpecAnFft();
+
+   void runFft(int16_t* inSamp, uint16_t* outSamp);
+   void runFftPower(int16_t* inSamp, float* outPower); // Squared magnitude (no square roots).
+
+   // Let runFftPower know that only bins 'firstBin' to 'firstBin+numBins-1' are used. planUsedBins times
+   // computing just those bins (Goertzel) against the full FFT on this CPU. It doesn't touch anything
+   // runFftPower uses, so it can run while runFftPower is running on another thread.
+   void planUsedBins(int firstBin, int numBins);
+
+   // Switch runFftPower over to whichever one planUsedBins picked (must not run at the same time as
+   // runFftPower). Returns true if the partial spectrum evaluation was selected.
+   bool applyUsedBins();
+
+   const char* getBackendName(){return m_backend->getName();}
+   const std::vector<int16_t>& getWindowCoefs(){return m_windowCoefs;}
+private:
+   // Make uncopyable
+   SpecAnFft();
+   SpecAnFft(SpecAnFft const&);
+   void operator=(SpecAnFft const&);
+
+   std::unique_ptr<FftBackend> m_backend;
+   std::unique_ptr<GoertzelBank> m_goertzel; // Only set when it is faster than m_backend
+   std::unique_ptr<GoertzelBank> m_plannedGoertzel; // Next m_goertzel (see planUsedBins)
+
+   int m_numTaps;
+   FftBackend::eBackendType m_backendType; // The type of m_backend
+   std::vector<int16_t> m_windowCoefs;
+};
+
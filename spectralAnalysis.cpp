@@ -0,0 +1,250 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <algorithm> // std::min, std::max, std::find
+#include "spectralAnalysis.h"
+#include "ThreadPriorities.h"
+
+
+SpectralAnalysis::Spectrum::Spectrum(float sampleRate, int fftSize, float fftRate, int lowBandDecimation, SpecAnLedTypes::eChannel channel, WindowTables::eWindow window, FftBackend::eBackendType backendType):
+   m_fftSize(fftSize),
+   m_sampleRate(sampleRate),
+   m_channel(channel)
+{
+   if(lowBandDecimation > 1)
+   {
+      m_multiRes.reset(new MultiResAnalysis(sampleRate, fftSize, fftRate, lowBandDecimation, window, backendType));
+      m_binFreqs = m_multiRes->getBinFreqs();
+   }
+   else
+   {
+      m_fftRun.reset(new FftRunRate(sampleRate, fftSize, fftRate, FftRunRate::E_FFT_POLICY_LATEST_ONLY, window, backendType));
+      m_binFreqs.resize(fftSize>>1);
+      for(size_t i = 0; i < m_binFreqs.size(); ++i)
+         m_binFreqs[i] = i * sampleRate / fftSize;
+   }
+}
+
+SpectralAnalysis::Spectrum::Spectrum(float sampleRate, float startFreq, float stopFreq, int fftSize, float fftRate, SpecAnLedTypes::eChannel channel, WindowTables::eWindow window):
+   m_fftSize(fftSize),
+   m_sampleRate(sampleRate),
+   m_channel(channel)
+{
+   m_zoom.reset(new ZoomFft(sampleRate, startFreq, stopFreq, fftSize, fftRate, window));
+   m_binFreqs = m_zoom->getBinFreqs();
+}
+
+void SpectralAnalysis::Spectrum::updateUsedBins()
+{
+   // Union of the bins of all the displays.
+   int firstBin = 0;
+   int stopBin = 0;
+   if(!m_usedBins.empty())
+      firstBin = m_usedBins.begin()->first; // Sorted by first bin.
+   for(auto& bins : m_usedBins)
+      stopBin = std::max(stopBin, bins.second);
+
+   // Figure out the fastest way to compute those bins while the analysis keeps running, then switch over.
+   if(m_multiRes)
+      m_multiRes->planUsedBins(firstBin, stopBin - firstBin);
+   else if(m_fftRun)
+      m_fftRun->planUsedBins(firstBin, stopBin - firstBin);
+   // The zoom FFT only computes the band it covers anyway.
+
+   std::unique_lock<std::mutex> lock(*m_analysisMutex);
+   if(m_multiRes)
+      m_multiRes->applyUsedBins();
+   else if(m_fftRun)
+      m_fftRun->applyUsedBins();
+}
+
+void SpectralAnalysis::Spectrum::process(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp)
+{
+   const SpecAnLedTypes::tFftPowerVector* result;
+   if(m_multiRes)
+      result = m_multiRes->runPower(samples, numSamp);
+   else if(m_zoom)
+      result = m_zoom->runPower(samples, numSamp);
+   else
+      result = m_fftRun->runPower(samples, numSamp);
+   m_numSampProcessed += numSamp;
+   if(result != nullptr)
+   {
+      m_power = result;
+      m_resultTime = (double)m_numSampProcessed / m_sampleRate;
+      ++m_updateCount;
+   }
+}
+
+void SpectralAnalysis::Spectrum::flush()
+{
+   if(m_multiRes)
+      m_multiRes->flush();
+   else if(m_zoom)
+      m_zoom->flush();
+   else
+      m_fftRun->flush();
+}
+
+
+SpectralAnalysis::Spectrum::UsedBins::UsedBins(std::shared_ptr<Spectrum> spectrum, int firstBin, int numBins):
+   m_spectrum(spectrum),
+   m_bins(firstBin, firstBin + numBins)
+{
+   std::unique_lock<std::mutex> lock(m_spectrum->m_usedBinsMutex);
+   m_spectrum->m_usedBins.insert(m_bins);
+   m_spectrum->updateUsedBins();
+}
+
+SpectralAnalysis::Spectrum::UsedBins::~UsedBins()
+{
+   std::unique_lock<std::mutex> lock(m_spectrum->m_usedBinsMutex);
+   m_spectrum->m_usedBins.erase(m_spectrum->m_usedBins.find(m_bins));
+   m_spectrum->updateUsedBins();
+}
+
+
+SpectralAnalysis::SpectralAnalysis(float sampleRate, FftBackend::eBackendType backendType):
+   m_sampleRate(sampleRate),
+   m_backendType(backendType)
+{
+
+}
+
+SpectralAnalysis::~SpectralAnalysis()
+{
+   // Kill the right channel thread and join.
+   if(m_rightChannel_thread.joinable())
+   {
+      {
+         std::lock_guard<std::mutex> lock(m_rightChannel_mutex);
+         m_rightChannel_active = false;
+         m_rightChannel_condVar.notify_all();
+      }
+      m_rightChannel_thread.join();
+   }
+}
+
+std::shared_ptr<SpectralAnalysis::Spectrum> SpectralAnalysis::getSpectrum(int fftSize, float fftRate, int lowBandDecimation, SpecAnLedTypes::eChannel channel, WindowTables::eWindow window)
+{
+   std::unique_lock<std::mutex> lock(m_mutex);
+   auto& spectrum = m_spectra[tSpectrumKey(fftSize, fftRate, lowBandDecimation, channel, window)];
+   if(spectrum == nullptr)
+   {
+      spectrum.reset(new Spectrum(m_sampleRate, fftSize, fftRate, lowBandDecimation, channel, window, m_backendType));
+      spectrum->m_analysisMutex = &m_mutex;
+   }
+   return spectrum;
+}
+
+std::shared_ptr<SpectralAnalysis::Spectrum> SpectralAnalysis::getZoomSpectrum(float startFreq, float stopFreq, int fftSize, float fftRate, SpecAnLedTypes::eChannel channel, WindowTables::eWindow window)
+{
+   std::unique_lock<std::mutex> lock(m_mutex);
+   auto& spectrum = m_zoomSpectra[tZoomSpectrumKey(startFreq, stopFreq, fftSize, fftRate, channel, window)];
+   if(spectrum == nullptr)
+   {
+      spectrum.reset(new Spectrum(m_sampleRate, startFreq, stopFreq, fftSize, fftRate, channel, window));
+      spectrum->m_analysisMutex = &m_mutex;
+   }
+   return spectrum;
+}
+
+void SpectralAnalysis::process(const SpecAnLedTypes::tPcmSample* const* channelSamples, size_t numSamp, const tSpectrumList& spectra)
+{
+   std::unique_lock<std::mutex> lock(m_mutex);
+
+   // Figure out which spectra need to be run.
+   m_spectraToRun.clear();
+   m_rightChannel_spectra.clear();
+   for(auto& spectrum : m_spectra)
+      addToRun(spectrum.second.get(), spectra);
+   for(auto& spectrum : m_zoomSpectra)
+      addToRun(spectrum.second.get(), spectra);
+
+   // Hand the right channel off to its own thread.
+   bool runRight = m_rightChannel_spectra.size() > 0;
+   if(runRight)
+   {
+      if(!m_rightChannel_thread.joinable())
+      {
+         m_rightChannel_active = true;
+         m_rightChannel_thread = std::thread(&SpectralAnalysis::rightChannelFunc, this);
+      }
+      std::lock_guard<std::mutex> lock(m_rightChannel_mutex);
+      m_rightChannel_samples = channelSamples[SpecAnLedTypes::E_CHANNEL_RIGHT];
+      m_rightChannel_numSamp = numSamp;
+      m_rightChannel_busy = true;
+      m_rightChannel_condVar.notify_all();
+   }
+
+   // Run everything else on this thread.
+   for(auto spectrum : m_spectraToRun)
+      spectrum->process(channelSamples[spectrum->getChannel()], numSamp);
+
+   // Wait for the right channel to finish.
+   if(runRight)
+   {
+      std::unique_lock<std::mutex> lock(m_rightChannel_mutex);
+      while(m_rightChannel_busy)
+         m_rightChannel_condVar.wait(lock);
+   }
+}
+
+void SpectralAnalysis::flush()
+{
+   std::unique_lock<std::mutex> lock(m_mutex);
+   for(auto& spectrum : m_spectra)
+      spectrum.second->flush();
+   for(auto& spectrum : m_zoomSpectra)
+      spectrum.second->flush();
+}
+
+void SpectralAnalysis::addToRun(Spectrum* spectrum, const tSpectrumList& spectra)
+{
+   if(std::find(spectra.begin(), spectra.end(), spectrum) == spectra.end())
+      return;
+
+   if(spectrum->getChannel() == SpecAnLedTypes::E_CHANNEL_RIGHT)
+      m_rightChannel_spectra.push_back(spectrum);
+   else
+      m_spectraToRun.push_back(spectrum);
+}
+
+void SpectralAnalysis::rightChannelFunc()
+{
+   ThreadPriorities::setThisThreadName("SpecAnRight");
+   std::unique_lock<std::mutex> lock(m_rightChannel_mutex);
+   while(m_rightChannel_active)
+   {
+      // Wait for something to do.
+      while(!m_rightChannel_busy && m_rightChannel_active)
+         m_rightChannel_condVar.wait(lock);
+
+      if(m_rightChannel_busy)
+      {
+         // Keep the mutex unlocked while running the FFTs.
+         lock.unlock();
+         for(auto spectrum : m_rightChannel_spectra)
+            spectrum->process(m_rightChannel_samples, m_rightChannel_numSamp);
+         lock.lock();
+
+         m_rightChannel_busy = false;
+         m_rightChannel_condVar.notify_all();
+      }
+   }
+}
@@ -0,0 +1,167 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <map>
+#include <set>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "specAnLedPiTypes.h"
+#include "fftRunRate.h"
+#include "multiResAnalysis.h"
+#include "zoomFft.h"
+
+// Runs each FFT once per hop and shares the result with every display that uses it. With stereo
+// capture, the right channel's spectra are run on a separate thread (i.e. a separate core) in
+// parallel with everything else.
+class SpectralAnalysis
+{
+public:
+   // One spectrum (i.e. one FFT size / rate). Displays only read from this.
+   class Spectrum
+   {
+   public:
+      // Let the analysis know which bins a display uses, for as long as this exists. Only the union
+      // of the bins of the displays that still exist needs to be computed (see SpecAnFft::planUsedBins).
+      // Safe to create / destroy from any thread.
+      class UsedBins
+      {
+      public:
+         UsedBins(std::shared_ptr<Spectrum> spectrum, int firstBin, int numBins);
+         ~UsedBins();
+      private:
+         // Make uncopyable
+         UsedBins();
+         UsedBins(UsedBins const&);
+         void operator=(UsedBins const&);
+
+         std::shared_ptr<Spectrum> m_spectrum;
+         std::pair<int, int> m_bins; // First Bin, Stop Bin
+      };
+
+      // 'lowBandDecimation' > 1 makes this a multi-resolution spectrum (see MultiResAnalysis).
+      Spectrum(float sampleRate, int fftSize, float fftRate, int lowBandDecimation, SpecAnLedTypes::eChannel channel, WindowTables::eWindow window, FftBackend::eBackendType backendType);
+
+      // Zoom FFT spectrum, only covers 'startFreq' to 'stopFreq' (see ZoomFft).
+      Spectrum(float sampleRate, float startFreq, float stopFreq, int fftSize, float fftRate, SpecAnLedTypes::eChannel channel, WindowTables::eWindow window);
+
+      // Latest power spectrum (nullptr until the first FFT has run).
+      const SpecAnLedTypes::tFftPowerVector* getPower() const {return m_power;}
+
+      // Incremented every time a new spectrum is computed.
+      uint64_t getUpdateCount() const {return m_updateCount;}
+
+      // Time (seconds of processed audio) when the latest spectrum was computed.
+      double getResultTime() const {return m_resultTime;}
+
+      int getFftSize() const {return m_fftSize;}
+
+      SpecAnLedTypes::eChannel getChannel() const {return m_channel;}
+
+      // Center frequency (Hz) of each bin in the power spectrum.
+      const std::vector<float>& getBinFreqs() const {return m_binFreqs;}
+
+   private:
+      // Make uncopyable
+      Spectrum();
+      Spectrum(Spectrum const&);
+      void operator=(Spectrum const&);
+
+      friend class SpectralAnalysis;
+      void process(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp);
+      void flush();
+
+      int m_fftSize;
+      float m_sampleRate;
+      SpecAnLedTypes::eChannel m_channel;
+      std::vector<float> m_binFreqs;
+      std::unique_ptr<FftRunRate> m_fftRun;
+      std::unique_ptr<MultiResAnalysis> m_multiRes;
+      std::unique_ptr<ZoomFft> m_zoom;
+      const SpecAnLedTypes::tFftPowerVector* m_power = nullptr;
+      uint64_t m_updateCount = 0;
+      uint64_t m_numSampProcessed = 0;
+      double m_resultTime = 0.0;
+
+      std::mutex m_usedBinsMutex; // Held while updating (timing the FFT is slow, so this isn't the analysis mutex).
+      std::multiset<std::pair<int, int>> m_usedBins; // First Bin, Stop Bin of each UsedBins
+      void updateUsedBins();
+
+      std::mutex* m_analysisMutex = nullptr; // The owning SpectralAnalysis' mutex.
+   };
+
+   typedef std::vector<const Spectrum*> tSpectrumList;
+
+   // 'backendType' picks the FFT precision (see FftBackend::getBackendType). Zoom FFTs are always float.
+   SpectralAnalysis(float sampleRate, FftBackend::eBackendType backendType = FftBackend::E_BACKEND_FASTEST);
+   virtual ~SpectralAnalysis();
+
+   // Returns the spectrum for the FFT size / rate, creating it if needed. Spectra (and their FFT
+   // plans) are cached, so all the displays that use the same FFT size and rate share one.
+   // Displays can be created on another thread while 'process' is running.
+   std::shared_ptr<Spectrum> getSpectrum(int fftSize, float fftRate, int lowBandDecimation = 1, SpecAnLedTypes::eChannel channel = SpecAnLedTypes::E_CHANNEL_MONO, WindowTables::eWindow window = WindowTables::E_WINDOW_BLACKMAN_HARRIS);
+
+   // Same as getSpectrum, but for a zoom FFT of the band from 'startFreq' to 'stopFreq'.
+   std::shared_ptr<Spectrum> getZoomSpectrum(float startFreq, float stopFreq, int fftSize, float fftRate, SpecAnLedTypes::eChannel channel = SpecAnLedTypes::E_CHANNEL_MONO, WindowTables::eWindow window = WindowTables::E_WINDOW_BLACKMAN_HARRIS);
+
+   // Run the spectra in 'spectra' on the new samples ('channelSamples' is indexed by eChannel).
+   // Spectra that aren't in the list just miss these samples, which is fine since only the
+   // latest FFT is displayed.
+   void process(const SpecAnLedTypes::tPcmSample* const* channelSamples, size_t numSamp, const tSpectrumList& spectra);
+
+   // Drop the samples buffered in all the spectra (e.g. after 'process' hasn't been called for a
+   // while), so the next FFTs don't window old audio.
+   void flush();
+
+private:
+   // Make uncopyable
+   SpectralAnalysis();
+   SpectralAnalysis(SpectralAnalysis const&);
+   void operator=(SpectralAnalysis const&);
+
+   float m_sampleRate;
+   FftBackend::eBackendType m_backendType;
+
+   std::mutex m_mutex; // Guards the spectra (and their used bins) while they are being processed.
+
+   typedef std::tuple<int, float, int, SpecAnLedTypes::eChannel, WindowTables::eWindow> tSpectrumKey; // FFT Size, FFT Rate, Low Band Decimation, Channel, Window
+   std::map<tSpectrumKey, std::shared_ptr<Spectrum>> m_spectra;
+
+   typedef std::tuple<float, float, int, float, SpecAnLedTypes::eChannel, WindowTables::eWindow> tZoomSpectrumKey; // Start Freq, Stop Freq, FFT Size, FFT Rate, Channel, Window
+   std::map<tZoomSpectrumKey, std::shared_ptr<Spectrum>> m_zoomSpectra;
+
+   std::vector<Spectrum*> m_spectraToRun;
+
+   // Right Channel Thread Stuff.
+   std::thread m_rightChannel_thread;
+   std::mutex m_rightChannel_mutex;
+   std::condition_variable m_rightChannel_condVar;
+   std::vector<Spectrum*> m_rightChannel_spectra;
+   const SpecAnLedTypes::tPcmSample* m_rightChannel_samples = nullptr;
+   size_t m_rightChannel_numSamp = 0;
+   bool m_rightChannel_busy = false;
+   bool m_rightChannel_active = false;
+   void rightChannelFunc();
+
+   void addToRun(Spectrum* spectrum, const tSpectrumList& spectra);
+};
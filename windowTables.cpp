@@ -0,0 +1,96 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include "windowTables.h"
+
+using namespace WindowTables;
+
+// All the tables are built by the compiler.
+template<int N, eWindow W>
+static constexpr tTableQ15<N> TABLE = makeTableQ15<N>(W);
+
+template<eWindow W>
+static const int16_t* lookupTable(int numTaps)
+{
+   switch(numTaps)
+   {
+      case 32:   return TABLE<32, W>.coefs;
+      case 64:   return TABLE<64, W>.coefs;
+      case 128:  return TABLE<128, W>.coefs;
+      case 256:  return TABLE<256, W>.coefs;
+      case 512:  return TABLE<512, W>.coefs;
+      case 1024: return TABLE<1024, W>.coefs;
+      case 2048: return TABLE<2048, W>.coefs;
+      default:   break;
+   }
+   return nullptr;
+}
+
+const int16_t* WindowTables::getTableQ15(eWindow window, int numTaps)
+{
+   switch(window)
+   {
+      case E_WINDOW_HANN:            return lookupTable<E_WINDOW_HANN>(numTaps);
+      case E_WINDOW_BLACKMAN:        return lookupTable<E_WINDOW_BLACKMAN>(numTaps);
+      case E_WINDOW_BLACKMAN_HARRIS: return lookupTable<E_WINDOW_BLACKMAN_HARRIS>(numTaps);
+      case E_WINDOW_FLAT_TOP:        return lookupTable<E_WINDOW_FLAT_TOP>(numTaps);
+      default:                       break;
+   }
+   return nullptr;
+}
+
+void WindowTables::getWindowQ15(eWindow window, int numTaps, std::vector<int16_t>& windowQ15)
+{
+   windowQ15.clear();
+   if(window == E_WINDOW_NONE)
+      return;
+
+   const int16_t* table = getTableQ15(window, numTaps);
+   if(table != nullptr)
+   {
+      windowQ15.assign(table, table+numTaps);
+   }
+   else
+   {
+      // No table for this size, compute it now.
+      windowQ15.resize(numTaps);
+      for(int i = 0; i < numTaps; ++i)
+         windowQ15[i] = toQ15(windowValue(window, i, numTaps));
+   }
+}
+
+void WindowTables::getWindow(eWindow window, int numTaps, std::vector<float>& windowOut)
+{
+   windowOut.resize(numTaps);
+   for(int i = 0; i < numTaps; ++i)
+      windowOut[i] = (window == E_WINDOW_NONE) ? 1.0f : windowValue(window, i, numTaps);
+}
+
+const char* WindowTables::getName(eWindow window)
+{
+   switch(window)
+   {
+      case E_WINDOW_NONE:            return "None";
+      case E_WINDOW_HANN:            return "Hann";
+      case E_WINDOW_BLACKMAN:        return "Blackman";
+      case E_WINDOW_BLACKMAN_HARRIS: return "Blackman-Harris";
+      case E_WINDOW_FLAT_TOP:        return "Flat Top";
+      default:                       break;
+   }
+   return "Unknown";
+}
@@ -0,0 +1,129 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+// FFT window library. The windows are all cosine sums, so the Q15 tables for the common power
+// of 2 sizes are generated at compile time (via a constexpr cosine). Picking a window at run time
+// is just a table lookup.
+namespace WindowTables
+{
+   typedef enum
+   {
+      E_WINDOW_NONE, // Rectangular (i.e. don't apply a window)
+      E_WINDOW_HANN,
+      E_WINDOW_BLACKMAN,
+      E_WINDOW_BLACKMAN_HARRIS,
+      E_WINDOW_FLAT_TOP,
+      E_NUM_WINDOWS
+   }eWindow;
+
+   // Table sizes that are generated at compile time.
+   static constexpr int MIN_TABLE_SIZE = 32;
+   static constexpr int MAX_TABLE_SIZE = 2048;
+
+   // Fills in 'windowQ15' with the window (empty for E_WINDOW_NONE). Sizes that don't have a
+   // compile time table are computed at run time with the same code.
+   void getWindowQ15(eWindow window, int numTaps, std::vector<int16_t>& windowQ15);
+
+   // Same as getWindowQ15, but floating point.
+   void getWindow(eWindow window, int numTaps, std::vector<float>& windowOut);
+
+   // Compile time table for 'numTaps' or nullptr if there isn't one.
+   const int16_t* getTableQ15(eWindow window, int numTaps);
+
+   const char* getName(eWindow window);
+
+   ////////////////////////////////////////////////////////////////////////////
+   // Compile time helpers
+   ////////////////////////////////////////////////////////////////////////////
+   static constexpr double PI = 3.14159265358979323846;
+
+   // Taylor series cosine, accurate to ~1e-14 (much better than Q15 needs).
+   constexpr double constexprCos(double x)
+   {
+      // Reduce to -pi to pi.
+      while(x > PI)
+         x -= 2.0*PI;
+      while(x < -PI)
+         x += 2.0*PI;
+
+      double x2 = x*x;
+      double term = 1.0;
+      double sum = 1.0;
+      for(int n = 1; n < 14; ++n)
+      {
+         term *= -x2 / ((2*n-1)*(2*n));
+         sum += term;
+      }
+      return sum;
+   }
+
+   // w[i] = a0 - a1*cos(2*pi*i/(N-1)) + a2*cos(4*pi*i/(N-1)) - a3*cos(6*pi*i/(N-1)) + a4*cos(8*pi*i/(N-1))
+   typedef struct
+   {
+      double a[5];
+   }tCosineSum;
+
+   constexpr tCosineSum getCosineSum(eWindow window)
+   {
+      return window == E_WINDOW_HANN            ? tCosineSum{{0.5, 0.5, 0.0, 0.0, 0.0}} :
+             window == E_WINDOW_BLACKMAN        ? tCosineSum{{0.42, 0.5, 0.08, 0.0, 0.0}} :
+             window == E_WINDOW_BLACKMAN_HARRIS ? tCosineSum{{0.35875, 0.48829, 0.14128, 0.01168, 0.0}} :
+             window == E_WINDOW_FLAT_TOP        ? tCosineSum{{0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368}} :
+                                                  tCosineSum{{1.0, 0.0, 0.0, 0.0, 0.0}};
+   }
+
+   constexpr double windowValue(eWindow window, int index, int numTaps)
+   {
+      tCosineSum cs = getCosineSum(window);
+      double angle = 2.0 * PI * index / (numTaps-1);
+      double sum = cs.a[0];
+      double sign = -1.0;
+      for(int k = 1; k < 5; ++k)
+      {
+         sum += sign * cs.a[k] * constexprCos(k * angle);
+         sign = -sign;
+      }
+      return sum;
+   }
+
+   constexpr int16_t toQ15(double value)
+   {
+      double scaled = value * 32768.0;
+      return scaled > 32767.0 ? 32767 : scaled < -32768.0 ? -32768 : (int16_t)scaled;
+   }
+
+   template<int N>
+   struct tTableQ15
+   {
+      int16_t coefs[N];
+   };
+
+   template<int N>
+   constexpr tTableQ15<N> makeTableQ15(eWindow window)
+   {
+      tTableQ15<N> table{};
+      for(int i = 0; i < N; ++i)
+         table.coefs[i] = toQ15(windowValue(window, i, N));
+      return table;
+   }
+}
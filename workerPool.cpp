@@ -0,0 +1,110 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include "workerPool.h"
+#include "ThreadPriorities.h"
+
+WorkerPool::WorkerPool(int numThreads, const std::string& threadName):
+   m_threadName(threadName),
+   m_nextJob(0),
+   m_numJobsDone(0)
+{
+   for(int i = 0; i < numThreads; ++i)
+      m_threads.emplace_back(&WorkerPool::threadFunc, this);
+}
+
+WorkerPool::~WorkerPool()
+{
+   // Kill the worker threads and join.
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_active = false;
+      m_startCondVar.notify_all();
+   }
+   for(auto& thread : m_threads)
+      thread.join();
+}
+
+void WorkerPool::run(int numJobs, const std::function<void(int)>& job)
+{
+   if(m_threads.size() == 0 || numJobs <= 1)
+   {
+      // Nothing to split up.
+      for(int i = 0; i < numJobs; ++i)
+         job(i);
+      return;
+   }
+
+   // Start the new batch.
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_job = &job;
+      m_numJobs = numJobs;
+      m_nextJob = 0;
+      m_numJobsDone = 0;
+      ++m_batchCount;
+      m_startCondVar.notify_all();
+   }
+
+   doJobs(job, numJobs);
+
+   // Wait for the jobs to finish and for the worker threads to be done with 'job'.
+   std::unique_lock<std::mutex> lock(m_mutex);
+   while(m_numJobsDone < numJobs || m_numBusyThreads > 0)
+      m_doneCondVar.wait(lock);
+   m_job = nullptr;
+}
+
+void WorkerPool::doJobs(const std::function<void(int)>& job, int numJobs)
+{
+   int jobIndex;
+   while((jobIndex = m_nextJob++) < numJobs)
+   {
+      job(jobIndex);
+      ++m_numJobsDone;
+   }
+}
+
+void WorkerPool::threadFunc()
+{
+   ThreadPriorities::setThisThreadName(m_threadName.c_str());
+   uint64_t lastBatchCount = 0;
+   std::unique_lock<std::mutex> lock(m_mutex);
+   while(m_active)
+   {
+      // Wait for a new batch.
+      while((m_batchCount == lastBatchCount || m_job == nullptr) && m_active)
+         m_startCondVar.wait(lock);
+
+      if(m_active)
+      {
+         lastBatchCount = m_batchCount;
+         auto job = m_job;
+         int numJobs = m_numJobs;
+         ++m_numBusyThreads;
+
+         // Keep the mutex unlocked while running the jobs.
+         lock.unlock();
+         doJobs(*job, numJobs);
+         lock.lock();
+
+         --m_numBusyThreads;
+         m_doneCondVar.notify_all();
+      }
+   }
+}
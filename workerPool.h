@@ -0,0 +1,66 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+// A few threads that split up a batch of jobs. The calling thread works on the batch too.
+class WorkerPool
+{
+public:
+   WorkerPool(int numThreads, const std::string& threadName);
+   virtual ~WorkerPool();
+
+   // Calls 'job(i)' for 'i' from 0 to 'numJobs'-1, spread across the threads. Returns after all
+   // the jobs are done.
+   void run(int numJobs, const std::function<void(int)>& job);
+
+   int getNumThreads(){return m_threads.size();}
+
+private:
+   // Make uncopyable
+   WorkerPool();
+   WorkerPool(WorkerPool const&);
+   void operator=(WorkerPool const&);
+
+   std::string m_threadName;
+   std::vector<std::thread> m_threads;
+   std::mutex m_mutex;
+   std::condition_variable m_startCondVar;
+   std::condition_variable m_doneCondVar;
+   bool m_active = true;
+
+   // The current batch.
+   const std::function<void(int)>* m_job = nullptr;
+   int m_numJobs = 0;
+   uint64_t m_batchCount = 0;
+   std::atomic<int> m_nextJob;
+   std::atomic<int> m_numJobsDone;
+   int m_numBusyThreads = 0;
+
+   void threadFunc();
+   void doJobs(const std::function<void(int)>& job, int numJobs);
+};
@@ -0,0 +1,175 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <algorithm> // std::copy, std::min
+#include "zoomFft.h"
+
+// Only use up to this fraction of each decimated rate (the decimation filters roll off above this).
+#define ZOOM_USABLE_FRACTION (0.8)
+
+
+ZoomFft::ZoomFft(float sampleRate, float startFreq, float stopFreq, int fftSize, float fftRate, WindowTables::eWindow window):
+   m_fftSize(fftSize)
+{
+   float rate = sampleRate;
+
+   // Real decimation. Keep 0 Hz to the stop frequency alias free.
+   float minRealRate = 2.0 * stopFreq / ZOOM_USABLE_FRACTION;
+   while(rate / 2.0 >= minRealRate)
+   {
+      int factor = (rate / 4.0 >= minRealRate) ? 4 : 2;
+      m_realStages.emplace_back(new Decimator(rate, factor, stopFreq));
+      rate /= factor;
+   }
+
+   // Mix down so the band is centered at 0 Hz.
+   float centerFreq = 0.5 * (startFreq + stopFreq);
+   double mixAngle = -2.0 * M_PI * centerFreq / rate;
+   m_mixStepRe = cos(mixAngle);
+   m_mixStepIm = sin(mixAngle);
+
+   // Complex decimation. The band is now -bandwidth/2 to +bandwidth/2.
+   float bandwidth = stopFreq - startFreq;
+   float minComplexRate = bandwidth / ZOOM_USABLE_FRACTION;
+   while(rate / 2.0 >= minComplexRate)
+   {
+      int factor = (rate / 4.0 >= minComplexRate) ? 4 : 2;
+      m_reStages.emplace_back(new Decimator(rate, factor, 0.5 * bandwidth));
+      m_imStages.emplace_back(new Decimator(rate, factor, 0.5 * bandwidth));
+      rate /= factor;
+   }
+   m_fftSampleRate = rate;
+
+   m_hopSize = (m_fftSampleRate / fftRate + 0.5); // Round to nearest whole number.
+   if(m_hopSize < 1)
+      m_hopSize = 1;
+
+   // Complex FFT (the float backend's complex FFT is half the size of its real FFT).
+   m_fft.reset(new FftBackendFloat(fftSize*2, FftBackendFloat::fastestKernel()));
+   m_fftInRe.resize(fftSize*2);
+   m_fftInIm.resize(fftSize*2);
+   m_windowedRe.resize(fftSize);
+   m_windowedIm.resize(fftSize);
+   m_fftPower.resize(fftSize);
+
+   WindowTables::getWindow(window, fftSize, m_window);
+
+   // Only output the bins that are in the band.
+   float hzPerBin = m_fftSampleRate / fftSize;
+   int halfSize = fftSize >> 1;
+   m_firstFftBin = ceilf((startFreq - centerFreq) / hzPerBin) + halfSize;
+   int lastFftBin = floorf((stopFreq - centerFreq) / hzPerBin) + halfSize;
+   if(m_firstFftBin < 0) m_firstFftBin = 0;
+   if(lastFftBin > fftSize-1) lastFftBin = fftSize-1;
+
+   m_binFreqs.resize(lastFftBin - m_firstFftBin + 1);
+   for(size_t i = 0; i < m_binFreqs.size(); ++i)
+      m_binFreqs[i] = centerFreq + (int(m_firstFftBin + i) - halfSize) * hzPerBin;
+   m_power.assign(m_binFreqs.size(), 0.0f);
+}
+
+void ZoomFft::flush()
+{
+   for(auto stages : {&m_realStages, &m_reStages, &m_imStages})
+   {
+      for(auto& stage : *stages)
+         stage->flush();
+   }
+   m_numSampInBuff = 0;
+   m_numSampSinceFft = 0;
+}
+
+const SpecAnLedTypes::tFftPowerVector* ZoomFft::runPower(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp)
+{
+   // Real decimation.
+   m_realBuff.resize(numSamp);
+   std::copy(samples, samples+numSamp, m_realBuff.begin());
+   numSamp = runStages(m_realStages, m_realBuff.data(), numSamp);
+
+   // Mix down, then complex decimation.
+   mixDown(m_realBuff.data(), numSamp);
+   runStages(m_reStages, m_reBuff.data(), numSamp);
+   numSamp = runStages(m_imStages, m_imBuff.data(), numSamp);
+
+   if(!addFftSamples(m_reBuff.data(), m_imBuff.data(), numSamp))
+      return nullptr;
+
+   // Window the latest FFT size worth of samples (the circular buffer is mirrored, so they are contiguous).
+   int readIndex = m_writeIndex; // Oldest sample
+   for(int i = 0; i < m_fftSize; ++i)
+   {
+      m_windowedRe[i] = m_fftInRe[readIndex+i] * m_window[i];
+      m_windowedIm[i] = m_fftInIm[readIndex+i] * m_window[i];
+   }
+   m_fft->runComplexFftPower(m_windowedRe.data(), m_windowedIm.data(), m_fftPower.data());
+
+   // Shift 0 Hz to the center and copy out the bins in the band.
+   int halfSize = m_fftSize >> 1;
+   for(size_t i = 0; i < m_power.size(); ++i)
+      m_power[i] = m_fftPower[(m_firstFftBin + i + halfSize) & (m_fftSize-1)];
+
+   return &m_power;
+}
+
+size_t ZoomFft::runStages(std::vector<std::unique_ptr<Decimator>>& stages, SpecAnLedTypes::tPcmSample* inOut, size_t numSamp)
+{
+   for(auto& stage : stages)
+      numSamp = stage->decimate(inOut, numSamp, inOut); // Safe in place, decimate copies the input first.
+   return numSamp;
+}
+
+void ZoomFft::mixDown(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp)
+{
+   m_reBuff.resize(numSamp);
+   m_imBuff.resize(numSamp);
+   for(size_t i = 0; i < numSamp; ++i)
+   {
+      m_reBuff[i] = lrint(samples[i] * m_mixRe);
+      m_imBuff[i] = lrint(samples[i] * m_mixIm);
+
+      double re = m_mixRe*m_mixStepRe - m_mixIm*m_mixStepIm;
+      m_mixIm   = m_mixRe*m_mixStepIm + m_mixIm*m_mixStepRe;
+      m_mixRe   = re;
+   }
+
+   // Keep the phasor on the unit circle.
+   double mag = sqrt(m_mixRe*m_mixRe + m_mixIm*m_mixIm);
+   m_mixRe /= mag;
+   m_mixIm /= mag;
+}
+
+bool ZoomFft::addFftSamples(const SpecAnLedTypes::tPcmSample* re, const SpecAnLedTypes::tPcmSample* im, size_t numSamp)
+{
+   for(size_t i = 0; i < numSamp; ++i)
+   {
+      m_fftInRe[m_writeIndex] = m_fftInRe[m_writeIndex+m_fftSize] = re[i];
+      m_fftInIm[m_writeIndex] = m_fftInIm[m_writeIndex+m_fftSize] = im[i];
+      if(++m_writeIndex == m_fftSize)
+         m_writeIndex = 0;
+   }
+
+   m_numSampInBuff = std::min(m_numSampInBuff + (int)numSamp, m_fftSize);
+   m_numSampSinceFft += numSamp;
+
+   // Only run the latest FFT (no point computing FFTs that won't be displayed).
+   if(m_numSampInBuff < m_fftSize || m_numSampSinceFft < m_hopSize)
+      return false;
+   m_numSampSinceFft %= m_hopSize;
+   return true;
+}
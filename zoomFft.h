@@ -0,0 +1,94 @@
+/* Copyright 2026 Dan Williams. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <memory>
+#include <vector>
+#include "specAnLedPiTypes.h"
+#include "decimator.h"
+#include "fftBackendFloat.h"
+#include "windowTables.h"
+
+// Zoom FFT. High frequency resolution in a narrow band (e.g. 20 to 250 Hz for kick drums) without
+// a huge full band FFT. The signal is decimated (real), mixed down so the band is centered on
+// 0 Hz, decimated again (complex) to just cover the band and then run through a small complex FFT.
+class ZoomFft
+{
+public:
+   ZoomFft(float sampleRate, float startFreq, float stopFreq, int fftSize, float fftRate, WindowTables::eWindow window);
+
+   // Returns nullptr if no new spectrum was computed.
+   const SpecAnLedTypes::tFftPowerVector* runPower(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp);
+
+   // Center frequency (Hz) of each bin in the output spectrum (only bins between the start and stop frequencies).
+   const std::vector<float>& getBinFreqs(){return m_binFreqs;}
+
+   float getFftSampleRate(){return m_fftSampleRate;}
+
+   // Drop the buffered samples, the next FFT only uses samples passed in after this.
+   void flush();
+
+private:
+   // Make uncopyable
+   ZoomFft();
+   ZoomFft(ZoomFft const&);
+   void operator=(ZoomFft const&);
+
+   int m_fftSize;
+   int m_hopSize;
+   float m_fftSampleRate;
+
+   // Real decimation (before the mix down).
+   std::vector<std::unique_ptr<Decimator>> m_realStages;
+
+   // Mix down (complex phasor, double precision so it doesn't drift).
+   double m_mixRe = 1.0;
+   double m_mixIm = 0.0;
+   double m_mixStepRe;
+   double m_mixStepIm;
+
+   // Complex decimation (after the mix down). Same filter on the real and imaginary parts.
+   std::vector<std::unique_ptr<Decimator>> m_reStages;
+   std::vector<std::unique_ptr<Decimator>> m_imStages;
+
+   // Working buffers.
+   SpecAnLedTypes::tPcmBuffer m_realBuff;
+   SpecAnLedTypes::tPcmBuffer m_reBuff;
+   SpecAnLedTypes::tPcmBuffer m_imBuff;
+
+   // Mirrored circular buffers of the complex samples going into the FFT.
+   std::vector<float> m_fftInRe;
+   std::vector<float> m_fftInIm;
+   int m_writeIndex = 0;
+   int m_numSampSinceFft = 0;
+   int m_numSampInBuff = 0;
+
+   std::unique_ptr<FftBackendFloat> m_fft;
+   std::vector<float> m_window;
+   std::vector<float> m_windowedRe;
+   std::vector<float> m_windowedIm;
+   std::vector<float> m_fftPower;
+
+   int m_firstFftBin; // FFT bin (after shifting 0 Hz to the center) of the first output bin.
+   std::vector<float> m_binFreqs;
+   SpecAnLedTypes::tFftPowerVector m_power;
+
+   size_t runStages(std::vector<std::unique_ptr<Decimator>>& stages, SpecAnLedTypes::tPcmSample* inOut, size_t numSamp);
+   void mixDown(const SpecAnLedTypes::tPcmSample* samples, size_t numSamp);
+   bool addFftSamples(const SpecAnLedTypes::tPcmSample* re, const SpecAnLedTypes::tPcmSample* im, size_t numSamp);
+};